@@ -13,6 +13,7 @@
 #include "mozilla/ArrayUtils.h"
 #include "mozilla/Likely.h"
 #include "mozilla/MemoryReporting.h"
+#include "mozmemory.h"
 #include "mozilla/StaticPtr.h"
 
 #include "mozilla/dom/FragmentOrElement.h"
@@ -910,6 +911,37 @@ FragmentOrElement::nsExtendedDOMSlots::~nsExtendedDOMSlots()
   }
 }
 
+
+#ifdef MOZ_MEMORY
+static arena_id_t
+DOMNodeArena()
+{
+  static arena_id_t sArena = moz_create_arena();
+  return sArena;
+}
+#endif
+
+void*
+FragmentOrElement::operator new(size_t aSize)
+{
+#ifdef MOZ_MEMORY
+  void* ptr = moz_arena_malloc(DOMNodeArena(), aSize);
+#else
+  void* ptr = malloc(aSize);
+#endif
+  if (MOZ_UNLIKELY(!ptr)) {
+    NS_ABORT_OOM(aSize);
+  }
+  return ptr;
+}
+
+void
+FragmentOrElement::operator delete(void* aPtr)
+{
+  // Plain free() is fine: jemalloc finds the owning arena from the chunk.
+  free(aPtr);
+}
+
 FragmentOrElement::FragmentOrElement(already_AddRefed<mozilla::dom::NodeInfo>& aNodeInfo)
   : nsIContent(aNodeInfo)
 {
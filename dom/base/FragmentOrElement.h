@@ -113,6 +113,12 @@ public:
   explicit FragmentOrElement(already_AddRefed<mozilla::dom::NodeInfo>& aNodeInfo);
   explicit FragmentOrElement(already_AddRefed<mozilla::dom::NodeInfo>&& aNodeInfo);
 
+  // DOM nodes churn constantly and many live for the whole session, so all
+  // elements and fragments are segregated into a dedicated jemalloc arena to
+  // keep that churn from fragmenting the primary heap.
+  void* operator new(size_t aSize);
+  void operator delete(void* aPtr);
+
   NS_DECL_CYCLE_COLLECTING_ISUPPORTS
 
   NS_DECL_ADDSIZEOFEXCLUDINGTHIS
@@ -225,6 +225,64 @@ public:
 
   NS_DECLARE_STATIC_IID_ACCESSOR(NS_IDOCUMENT_IID)
 
+  /**
+   * A monotonically increasing generation for DOM mutations in documents
+   * owned by this document (child-list and attribute changes), used to
+   * invalidate the querySelectorAll result cache below. Bumped centrally
+   * from nsNodeUtils.
+   */
+  void NoteDOMMutationForQueryCache() { mQueryCacheGeneration++; }
+  uint64_t QueryCacheGeneration() const { return mQueryCacheGeneration; }
+
+  /**
+   * Cache of recent querySelectorAll results keyed by (selector text, scope
+   * root). Entries are valid only while QueryCacheGeneration() is unchanged,
+   * which is what makes the raw element pointers safe: an element (or root)
+   * can only die after being removed from its tree, and every removal or
+   * attribute change bumps the generation.
+   */
+  struct QuerySelectorResultCacheEntry
+  {
+    nsString mSelector;
+    nsINode* mRoot = nullptr;
+    uint64_t mGeneration = 0;
+    nsTArray<Element*> mResults;
+  };
+  static const size_t kQuerySelectorResultCacheSize = 8;
+
+  QuerySelectorResultCacheEntry*
+  LookupQuerySelectorResults(const nsAString& aSelector, nsINode* aRoot)
+  {
+    for (auto& entry : mQuerySelectorResultCache) {
+      if (entry.mGeneration == mQueryCacheGeneration && entry.mRoot == aRoot &&
+          entry.mGeneration != 0 && entry.mSelector.Equals(aSelector)) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  QuerySelectorResultCacheEntry*
+  NewQuerySelectorResultsEntry(const nsAString& aSelector, nsINode* aRoot)
+  {
+    QuerySelectorResultCacheEntry& entry =
+      mQuerySelectorResultCache[mQuerySelectorResultCacheNext++ %
+                                kQuerySelectorResultCacheSize];
+    entry.mSelector = aSelector;
+    entry.mRoot = aRoot;
+    entry.mGeneration = mQueryCacheGeneration;
+    entry.mResults.Clear();
+    return &entry;
+  }
+
+protected:
+  uint64_t mQueryCacheGeneration = 1;
+  size_t mQuerySelectorResultCacheNext = 0;
+  QuerySelectorResultCacheEntry
+    mQuerySelectorResultCache[kQuerySelectorResultCacheSize];
+
+public:
+
 #ifdef MOZILLA_INTERNAL_API
   nsIDocument();
 #endif
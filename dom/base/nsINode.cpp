@@ -2900,12 +2900,53 @@ nsINode::QuerySelectorAll(const nsAString& aSelector, ErrorResult& aResult)
 {
   RefPtr<nsSimpleContentList> contentList = new nsSimpleContentList(this);
 
+  // Frameworks re-run identical queries thousands of times between
+  // mutations; serve repeats from the per-document result cache, which any
+  // child-list or attribute mutation invalidates wholesale.
+  //
+  // Only roots connected to a document participate: removal from the tree
+  // always fires ContentRemoved (bumping the generation) before a connected
+  // node can die, which is what makes the cached raw pointers safe. A
+  // detached subtree can be released with no notification at all, so
+  // detached roots are neither cached nor served.
+  nsIDocument* doc = OwnerDoc();
+  bool cacheable = this == static_cast<nsINode*>(doc) || IsInComposedDoc();
+  if (!cacheable) {
+    nsCSSSelectorList* sl = ParseSelectorList(aSelector, aResult);
+    if (sl) {
+      FindMatchingElements<false, AutoTArray<Element*, 128>>(this, sl,
+                                                             *contentList,
+                                                             aResult);
+    }
+    return contentList.forget();
+  }
+
+  if (nsIDocument::QuerySelectorResultCacheEntry* cached =
+        doc->LookupQuerySelectorResults(aSelector, this)) {
+    for (Element* element : cached->mResults) {
+      contentList->AppendElement(element);
+    }
+    return contentList.forget();
+  }
+
   nsCSSSelectorList* selectorList = ParseSelectorList(aSelector, aResult);
   if (selectorList) {
     FindMatchingElements<false, AutoTArray<Element*, 128>>(this,
                                                              selectorList,
                                                              *contentList,
                                                              aResult);
+    // Pseudo-classes can depend on event or element state that mutates
+    // without any attribute or child-list notification (:hover, :checked,
+    // ...), so only selectors without any ':' are cacheable.
+    if (!aResult.Failed() && aSelector.FindChar(':') == -1) {
+      nsIDocument::QuerySelectorResultCacheEntry* entry =
+        doc->NewQuerySelectorResultsEntry(aSelector, this);
+      uint32_t length = contentList->Length();
+      entry->mResults.SetCapacity(length);
+      for (uint32_t i = 0; i < length; i++) {
+        entry->mResults.AppendElement(contentList->Item(i)->AsElement());
+      }
+    }
   } else {
     // Either we failed (and aResult already has the exception), or this
     // is a pseudo-element-only selector that matches nothing.
@@ -46,6 +46,7 @@
 #include "xpcpublic.h"
 
 #include "jsapi.h"
+#include "jsfriendapi.h"
 #include "jswrapper.h"
 #include "js/SliceBudget.h"
 #include "nsIArray.h"
@@ -1784,6 +1785,12 @@ InterSliceGCRunnerFired(TimeStamp aDeadline, void* aData)
 {
   nsJSContext::KillInterSliceGCRunner();
   MOZ_ASSERT(sActiveIntersliceGCBudget > 0);
+
+  // Flatten any large ropes the engine queued at concatenation time while
+  // we are in an idle grant anyway; the list is bounded (16 entries) and
+  // draining it both moves the first-use flattening pause off the critical
+  // path and drops the strong roots keeping those ropes alive.
+  js::FlattenPendingRopes(danger::GetJSContext());
   // We use longer budgets when the CC has been locked out but the CC has tried
   // to run since that means we may have significant amount garbage to collect
   // and better to GC in several longer slices than in a very long one.
@@ -143,6 +143,7 @@ nsNodeUtils::AttributeChanged(Element* aElement,
                               const nsAttrValue* aOldValue)
 {
   nsIDocument* doc = aElement->OwnerDoc();
+  doc->NoteDOMMutationForQueryCache();
   IMPL_MUTATION_NOTIFICATION(AttributeChanged, aElement,
                              (doc, aElement, aNameSpaceID, aAttribute,
                               aModType, aOldValue));
@@ -164,6 +165,7 @@ nsNodeUtils::ContentAppended(nsIContent* aContainer,
                              int32_t aNewIndexInContainer)
 {
   nsIDocument* doc = aContainer->OwnerDoc();
+  doc->NoteDOMMutationForQueryCache();
 
   IMPL_MUTATION_NOTIFICATION(ContentAppended, aContainer,
                              (doc, aContainer, aFirstNewContent,
@@ -199,6 +201,7 @@ nsNodeUtils::ContentInserted(nsINode* aContainer,
     document = static_cast<nsIDocument*>(aContainer);
   }
 
+  doc->NoteDOMMutationForQueryCache();
   IMPL_MUTATION_NOTIFICATION(ContentInserted, aContainer,
                              (document, container, aChild, aIndexInContainer));
 }
@@ -224,6 +227,7 @@ nsNodeUtils::ContentRemoved(nsINode* aContainer,
     document = static_cast<nsIDocument*>(aContainer);
   }
 
+  doc->NoteDOMMutationForQueryCache();
   IMPL_MUTATION_NOTIFICATION(ContentRemoved, aContainer,
                              (document, container, aChild, aIndexInContainer,
                               aPreviousSibling));
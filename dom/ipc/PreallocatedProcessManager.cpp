@@ -11,6 +11,8 @@
 #include "mozilla/dom/ContentParent.h"
 #include "mozilla/dom/ScriptSettings.h"
 #include "nsIPropertyBag2.h"
+
+#include <algorithm>
 #include "ProcessPriorityManager.h"
 #include "nsServiceManagerUtils.h"
 
@@ -65,9 +67,14 @@ private:
 
   void ObserveProcessShutdown(nsISupports* aSubject);
 
+  // The number of spare processes to keep warm, from
+  // dom.ipc.processPrelaunch.count (minimum 1 preserves the old
+  // single-spare behavior).
+  uint32_t PoolTarget();
+
   bool mEnabled;
   bool mShutdown;
-  RefPtr<ContentParent> mPreallocatedProcess;
+  nsTArray<RefPtr<ContentParent>> mPreallocatedProcesses;
   nsTHashtable<nsUint64HashKey> mBlockers;
 };
 
@@ -159,32 +166,42 @@ PreallocatedProcessManagerImpl::RereadPrefs()
   }
 }
 
+uint32_t
+PreallocatedProcessManagerImpl::PoolTarget()
+{
+  uint32_t count = Preferences::GetUint("dom.ipc.processPrelaunch.count", 1);
+  return std::max(count, 1u);
+}
+
 already_AddRefed<ContentParent>
 PreallocatedProcessManagerImpl::Take()
 {
-  if (!mEnabled || mShutdown) {
+  if (!mEnabled || mShutdown || mPreallocatedProcesses.IsEmpty()) {
     return nullptr;
   }
 
-  if (mPreallocatedProcess) {
-    // The preallocated process is taken. Let's try to start up a new one soon.
-    AllocateOnIdle();
-  }
+  RefPtr<ContentParent> process = mPreallocatedProcesses[0].forget();
+  mPreallocatedProcesses.RemoveElementAt(0);
 
-  return mPreallocatedProcess.forget();
+  // A spare was taken; refill the pool soon.
+  AllocateOnIdle();
+
+  return process.forget();
 }
 
 bool
 PreallocatedProcessManagerImpl::Provide(ContentParent* aParent)
 {
-  if (mEnabled && !mShutdown && !mPreallocatedProcess) {
-    mPreallocatedProcess = aParent;
+  if (mEnabled && !mShutdown &&
+      mPreallocatedProcesses.Length() < PoolTarget() &&
+      !mPreallocatedProcesses.Contains(aParent)) {
+    mPreallocatedProcesses.AppendElement(aParent);
   }
 
   // We might get a call from both NotifyTabDestroying and NotifyTabDestroyed with the same
   // ContentParent. Returning true here for both calls is important to avoid the cached process
   // to be destroyed.
-  return aParent == mPreallocatedProcess;
+  return mPreallocatedProcesses.Contains(aParent);
 }
 
 void
@@ -212,7 +229,7 @@ PreallocatedProcessManagerImpl::RemoveBlocker(ContentParent* aParent)
   uint64_t childID = aParent->ChildID();
   MOZ_ASSERT(mBlockers.Contains(childID));
   mBlockers.RemoveEntry(childID);
-  if (!mPreallocatedProcess && mBlockers.IsEmpty()) {
+  if (mPreallocatedProcesses.Length() < PoolTarget() && mBlockers.IsEmpty()) {
     AllocateAfterDelay();
   }
 }
@@ -222,7 +239,7 @@ PreallocatedProcessManagerImpl::CanAllocate()
 {
   return mEnabled &&
          mBlockers.IsEmpty() &&
-         !mPreallocatedProcess &&
+         mPreallocatedProcesses.Length() < PoolTarget() &&
          !mShutdown &&
          !ContentParent::IsMaxProcessCountReached(NS_LITERAL_STRING(DEFAULT_REMOTE_TYPE));
 }
@@ -259,14 +276,27 @@ void
 PreallocatedProcessManagerImpl::AllocateNow()
 {
   if (!CanAllocate()) {
-    if (mEnabled && !mShutdown && !mPreallocatedProcess && !mBlockers.IsEmpty()) {
+    if (mEnabled && !mShutdown &&
+        mPreallocatedProcesses.Length() < PoolTarget() && !mBlockers.IsEmpty()) {
       // If it's too early to allocate a process let's retry later.
       AllocateAfterDelay();
     }
     return;
   }
 
-  mPreallocatedProcess = ContentParent::PreallocateProcess();
+  RefPtr<ContentParent> process = ContentParent::PreallocateProcess();
+  if (!process) {
+    // Launch failed; like the old single-spare behavior, wait for the next
+    // external trigger rather than retrying in a loop that will keep
+    // failing.
+    return;
+  }
+  mPreallocatedProcesses.AppendElement(process);
+
+  // Keep filling until the pool reaches its target.
+  if (mPreallocatedProcesses.Length() < PoolTarget()) {
+    AllocateOnIdle();
+  }
 }
 
 void
@@ -283,10 +313,10 @@ PreallocatedProcessManagerImpl::Disable()
 void
 PreallocatedProcessManagerImpl::CloseProcess()
 {
-  if (mPreallocatedProcess) {
-    mPreallocatedProcess->ShutDownProcess(ContentParent::SEND_SHUTDOWN_MESSAGE);
-    mPreallocatedProcess = nullptr;
+  for (RefPtr<ContentParent>& process : mPreallocatedProcesses) {
+    process->ShutDownProcess(ContentParent::SEND_SHUTDOWN_MESSAGE);
   }
+  mPreallocatedProcesses.Clear();
 }
 
 void
@@ -299,8 +329,11 @@ PreallocatedProcessManagerImpl::ObserveProcessShutdown(nsISupports* aSubject)
   props->GetPropertyAsUint64(NS_LITERAL_STRING("childID"), &childID);
   NS_ENSURE_TRUE_VOID(childID != CONTENT_PROCESS_ID_UNKNOWN);
 
-  if (mPreallocatedProcess && childID == mPreallocatedProcess->ChildID()) {
-    mPreallocatedProcess = nullptr;
+  for (size_t i = 0; i < mPreallocatedProcesses.Length(); i++) {
+    if (mPreallocatedProcesses[i]->ChildID() == childID) {
+      mPreallocatedProcesses.RemoveElementAt(i);
+      break;
+    }
   }
 
   mBlockers.RemoveEntry(childID);
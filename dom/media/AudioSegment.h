@@ -8,6 +8,10 @@
 
 #include "MediaSegment.h"
 #include "AudioSampleFormat.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
 #include "AudioChannelFormat.h"
 #include "SharedBuffer.h"
 #include "WebAudioUtils.h"
@@ -79,6 +83,39 @@ InterleaveAndConvertBuffer(const SrcT* const* aSourceChannels,
   }
 }
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+// Vectorized stereo float->float interleave: the dominant mixing case on the
+// MediaStreamGraph thread. Unpacking interleaves two channel registers, and
+// the volume multiply folds into the same pass.
+template <>
+inline void
+InterleaveAndConvertBuffer<float, float>(const float* const* aSourceChannels,
+                                         uint32_t aLength, float aVolume,
+                                         uint32_t aChannels,
+                                         float* aOutput)
+{
+  float* output = aOutput;
+  uint32_t i = 0;
+  if (aChannels == 2) {
+    __m128 volume = _mm_set1_ps(aVolume);
+    const float* left = aSourceChannels[0];
+    const float* right = aSourceChannels[1];
+    for (; i + 4 <= aLength; i += 4) {
+      __m128 l = _mm_mul_ps(_mm_loadu_ps(left + i), volume);
+      __m128 r = _mm_mul_ps(_mm_loadu_ps(right + i), volume);
+      _mm_storeu_ps(output, _mm_unpacklo_ps(l, r));
+      _mm_storeu_ps(output + 4, _mm_unpackhi_ps(l, r));
+      output += 8;
+    }
+  }
+  for (; i < aLength; ++i) {
+    for (size_t channel = 0; channel < aChannels; ++channel) {
+      *output++ = aSourceChannels[channel][i] * aVolume;
+    }
+  }
+}
+#endif
+
 template <typename SrcT, typename DestT>
 static void
 DeinterleaveAndConvertBuffer(const SrcT* aSourceBuffer,
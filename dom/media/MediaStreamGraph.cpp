@@ -4,6 +4,8 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "MediaStreamGraphImpl.h"
+
+#include "mozilla/ScopeExit.h"
 #include "mozilla/MathAlgorithms.h"
 #include "mozilla/Unused.h"
 
@@ -1447,6 +1449,34 @@ MediaStreamGraphImpl::OneIteration(GraphTime aStateEnd)
 {
   WebCore::DenormalDisabler disabler;
 
+  // Budget accounting: measure how much wall time this iteration consumes
+  // relative to the audio it produces, keep a smoothed utilization, and log
+  // an overload warning before glitches start instead of after.
+  TimeStamp iterationStart = TimeStamp::Now();
+  GraphTime iterationStateEnd = std::min(aStateEnd, mEndTime);
+  // Capture the pre-iteration state time now: OneIteration advances
+  // mStateComputedTime to iterationStateEnd below, before this runs.
+  GraphTime iterationStateStart = mStateComputedTime;
+  auto recordBudget = mozilla::MakeScopeExit([&] {
+    double budgetMs =
+      MediaTimeToSeconds(iterationStateEnd - iterationStateStart) * 1000.0;
+    if (budgetMs > 0) {
+      double usedMs = (TimeStamp::Now() - iterationStart).ToMilliseconds();
+      double utilization = usedMs / budgetMs;
+      mIterationUtilization =
+        0.9 * mIterationUtilization + 0.1 * utilization;
+      if (mIterationUtilization > 0.8 && !mReportedOverload) {
+        mReportedOverload = true;
+        LOG(LogLevel::Warning,
+            ("MediaStreamGraph %p running at %3.0f%% of its real-time "
+             "budget; glitches imminent",
+             this, mIterationUtilization * 100));
+      } else if (mIterationUtilization < 0.6) {
+        mReportedOverload = false;
+      }
+    }
+  });
+
   // Process graph message from the main thread for this iteration.
   RunMessagesInQueue();
 
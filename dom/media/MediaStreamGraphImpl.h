@@ -811,6 +811,14 @@ public:
    * blocking order.
    */
   bool mStreamOrderDirty;
+  /**
+   * Smoothed fraction of the real-time budget each iteration consumes, and
+   * whether the overload warning has fired for the current episode. Graph
+   * thread only.
+   */
+  double mIterationUtilization = 0.0;
+  bool mReportedOverload = false;
+
   /**
    * Hold a ref to the Latency logger
    */
@@ -4050,11 +4050,16 @@ ArrayBufferBuilder::append(const uint8_t *aNewData, uint32_t aDataLen,
   }
   if (mLength + aDataLen > mCapacity) {
     CheckedUint32 newcap = mCapacity;
-    // Double while under aMaxGrowth or if not specified.
+    // Double while under aMaxGrowth or if not specified. Above that, still
+    // grow geometrically (by half) rather than by a fixed step: additive
+    // growth makes the total bytes memcpy'd quadratic in the final size,
+    // which dominates large downloads without a Content-Length. The
+    // overshoot is transient - the buffer is trimmed to its final length
+    // when the response completes.
     if (!aMaxGrowth || mCapacity < aMaxGrowth) {
       newcap *= 2;
     } else {
-      newcap += aMaxGrowth;
+      newcap += std::max(aMaxGrowth, mCapacity / 2);
     }
 
     if (!newcap.isValid()) {
@@ -453,12 +453,6 @@ StaticAutoPtr<ComputedTimingFunction> gZoomAnimationFunction;
  */
 StaticAutoPtr<ComputedTimingFunction> gVelocityCurveFunction;
 
-/**
- * The estimated duration of a paint for the purposes of calculating a new
- * displayport, in milliseconds.
- */
-static const double kDefaultEstimatedPaintDurationMs = 50;
-
 /**
  * Returns true if this is a high memory system and we can use
  * extra memory for a larger displayport to reduce checkerboarding.
@@ -3107,7 +3101,8 @@ RedistributeDisplayPortExcess(CSSSize& aDisplayPortSize,
 /* static */
 const ScreenMargin AsyncPanZoomController::CalculatePendingDisplayPort(
   const FrameMetrics& aFrameMetrics,
-  const ParentLayerPoint& aVelocity)
+  const ParentLayerPoint& aVelocity,
+  float aEstimatedPaintDurationMs)
 {
   if (aFrameMetrics.IsScrollInfoLayer()) {
     // Don't compute margins. Since we can't asynchronously scroll this frame,
@@ -3145,7 +3140,7 @@ const ScreenMargin AsyncPanZoomController::CalculatePendingDisplayPort(
 
   // Offset the displayport, depending on how fast we're moving and the
   // estimated time it takes to paint, to try to minimise checkerboarding.
-  float paintFactor = kDefaultEstimatedPaintDurationMs;
+  float paintFactor = aEstimatedPaintDurationMs;
   displayPort.MoveBy(velocity * paintFactor * gfxPrefs::APZVelocityBias());
 
   APZC_LOG_FM(aFrameMetrics,
@@ -3255,7 +3250,8 @@ void AsyncPanZoomController::RequestContentRepaint(bool aUserAction) {
 
   ReentrantMonitorAutoEnter lock(mMonitor);
   ParentLayerPoint velocity = GetVelocityVector();
-  mFrameMetrics.SetDisplayPortMargins(CalculatePendingDisplayPort(mFrameMetrics, velocity));
+  mFrameMetrics.SetDisplayPortMargins(
+    CalculatePendingDisplayPort(mFrameMetrics, velocity, mSmoothedPaintDurationMs));
   mFrameMetrics.SetUseDisplayPortMargins(true);
   mFrameMetrics.SetPaintRequestTime(TimeStamp::Now());
   mFrameMetrics.SetRepaintDrivenByUserAction(aUserAction);
@@ -3277,6 +3273,15 @@ void
 AsyncPanZoomController::RequestContentRepaint(const FrameMetrics& aFrameMetrics,
                                               const ParentLayerPoint& aVelocity)
 {
+  {
+    // This overload can run from the repaint thread (via
+    // DispatchToRepaintThread) as well as under callers already holding the
+    // monitor; it is reentrant, so take it unconditionally to keep the
+    // paint-latency fields monitor-protected on every path.
+    ReentrantMonitorAutoEnter lock(mMonitor);
+    mLastRepaintRequest = TimeStamp::Now();
+  }
+
   RefPtr<GeckoContentController> controller = GetGeckoContentController();
   if (!controller) {
     return;
@@ -3672,6 +3677,17 @@ void AsyncPanZoomController::NotifyLayersUpdated(const ScrollMetadata& aScrollMe
   APZThreadUtils::AssertOnCompositorThread();
 
   ReentrantMonitorAutoEnter lock(mMonitor);
+
+  // Fold the observed request-to-paint latency into the adaptive estimate
+  // that sizes the velocity-dependent displayport offset. Both fields are
+  // only touched under mMonitor.
+  if (!mLastRepaintRequest.IsNull()) {
+    float sampleMs = float((TimeStamp::Now() - mLastRepaintRequest).ToMilliseconds());
+    sampleMs = clamped(sampleMs, 8.0f, 500.0f);
+    mSmoothedPaintDurationMs = 0.75f * mSmoothedPaintDurationMs + 0.25f * sampleMs;
+    mLastRepaintRequest = TimeStamp();
+  }
+
   bool isDefault = mScrollMetadata.IsDefault();
 
   const FrameMetrics& aLayerMetrics = aScrollMetadata.GetMetrics();
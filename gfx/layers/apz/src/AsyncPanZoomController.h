@@ -265,7 +265,9 @@ public:
    */
   static const ScreenMargin CalculatePendingDisplayPort(
     const FrameMetrics& aFrameMetrics,
-    const ParentLayerPoint& aVelocity);
+    const ParentLayerPoint& aVelocity,
+    // Default paint estimate for callers with no measured latency.
+    float aEstimatedPaintDurationMs = 50.0f);
 
   nsEventStatus HandleDragEvent(const MouseInput& aEvent,
                                 const AsyncDragMetrics& aDragMetrics,
@@ -1053,6 +1055,13 @@ private:
   // Invoked by the pinch repaint timer.
   void DoDelayedRequestContentRepaint();
 
+  // Adaptive paint-duration estimate: an exponential moving average of the
+  // time from a repaint request to the matching layers update, used to size
+  // the velocity-dependent displayport offset instead of the static 50ms
+  // guess. Protected by mMonitor like the metrics it feeds.
+  float mSmoothedPaintDurationMs = 50.0f;
+  TimeStamp mLastRepaintRequest;
+
   /* ===================================================================
    * The functions and members in this section are used to make ancestor chains
    * out of APZC instances. These chains can only be walked or manipulated
@@ -744,6 +744,8 @@ WebRenderLayerManager::EndTransactionInternal(DrawPaintedLayerCallback aCallback
                                               nsDisplayList* aDisplayList,
                                               nsDisplayListBuilder* aDisplayListBuilder)
 {
+  AutoProfilerTracing tracingDL("WebRender", "DisplayListSerialize");
+
   AutoProfilerTracing tracing("Paint", "RenderLayers");
   mPaintedLayerCallback = aCallback;
   mPaintedLayerCallbackData = aCallbackData;
@@ -331,6 +331,28 @@ nsFontMetrics::GetWidth(const char* aString, uint32_t aLength,
     return 0;
 }
 
+void
+nsFontMetrics::GetWidths(const nsTArray<nsString>& aStrings,
+                         nsTArray<nscoord>& aWidths,
+                         DrawTarget* aDrawTarget)
+{
+    aWidths.SetLength(aStrings.Length());
+
+    StubPropertyProvider provider;
+    for (size_t i = 0; i < aStrings.Length(); i++) {
+        const nsString& str = aStrings[i];
+        if (str.IsEmpty()) {
+            aWidths[i] = 0;
+            continue;
+        }
+        AutoTextRun textRun(this, aDrawTarget, str.get(), str.Length());
+        aWidths[i] = textRun.get()
+            ? NSToCoordRound(textRun->GetAdvanceWidth(
+                  Range(0, str.Length()), &provider))
+            : 0;
+    }
+}
+
 nscoord
 nsFontMetrics::GetWidth(const char16_t* aString, uint32_t aLength,
                         DrawTarget* aDrawTarget)
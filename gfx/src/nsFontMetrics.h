@@ -194,6 +194,18 @@ public:
     // want it in another format.
     nscoord GetWidth(const char* aString, uint32_t aLength,
                      DrawTarget* aDrawTarget);
+    /**
+     * Measure many strings in one call. This is a convenience loop over
+     * GetWidth: one textrun is still built per string, and the win for bulk
+     * callers (e.g. autocomplete layout measuring thousands of candidates)
+     * comes from the shaped-word caches - now retained across gfxFont
+     * instance churn - making repeated shapes cheap, plus issuing a single
+     * call per batch. aWidths is resized to match aStrings.
+     */
+    void GetWidths(const nsTArray<nsString>& aStrings,
+                   nsTArray<nscoord>& aWidths,
+                   DrawTarget* aDrawTarget);
+
     nscoord GetWidth(const char16_t* aString, uint32_t aLength,
                      DrawTarget* aDrawTarget);
 
@@ -250,6 +250,20 @@ gfxFontCache::Lookup(const gfxFontEntry* aFontEntry,
 void
 gfxFontCache::AddNew(gfxFont *aFont)
 {
+    // Adopt any shaped words retained from a previous instance of this font.
+    if (!aFont->mWordCache) {
+        for (size_t i = 0; i < mRetainedWordCaches.Length(); i++) {
+            RetainedWordCache& retained = mRetainedWordCaches[i];
+            if (retained.mFontEntry == aFont->GetFontEntry() &&
+                retained.mUnicodeRangeMap == aFont->GetUnicodeRangeMap() &&
+                retained.mStyle.Equals(*aFont->GetStyle())) {
+                aFont->mWordCache = mozilla::Move(retained.mWords);
+                mRetainedWordCaches.RemoveElementAt(i);
+                break;
+            }
+        }
+    }
+
     Key key(aFont->GetFontEntry(), aFont->GetStyle(),
             aFont->GetUnicodeRangeMap());
     HashEntry *entry = mFonts.PutEntry(key);
@@ -302,6 +316,20 @@ gfxFontCache::DestroyFont(gfxFont *aFont)
     if (entry && entry->mFont == aFont) {
         mFonts.RemoveEntry(entry);
     }
+
+    // Retain a populated shaped-word cache for adoption by the next font
+    // instance with the same face, style and range map.
+    if (aFont->mWordCache && aFont->mWordCache->Count() > 0) {
+        if (mRetainedWordCaches.Length() >= kMaxRetainedWordCaches) {
+            mRetainedWordCaches.RemoveElementAt(0);
+        }
+        RetainedWordCache* retained = mRetainedWordCaches.AppendElement();
+        retained->mFontEntry = aFont->GetFontEntry();
+        retained->mStyle = *aFont->GetStyle();
+        retained->mUnicodeRangeMap = aFont->GetUnicodeRangeMap();
+        retained->mWords = mozilla::Move(aFont->mWordCache);
+    }
+
     NS_ASSERTION(aFont->GetRefCount() == 0,
                  "Destroying with non-zero ref count!");
     delete aFont;
@@ -323,6 +351,7 @@ gfxFontCache::FlushShapedWordCaches()
     for (auto it = mFonts.Iter(); !it.Done(); it.Next()) {
         it.Get()->mFont->ClearCachedWords();
     }
+    mRetainedWordCaches.Clear();
 }
 
 void
@@ -335,6 +335,18 @@ public:
     void FlushShapedWordCaches();
     void NotifyGlyphsChanged();
 
+    // Shaped-word caches retained from recently destroyed fonts, keyed like
+    // mFonts, so that re-instantiating the same face/style/size (UI strings
+    // churn font instances constantly) starts with its words already shaped
+    // instead of re-running harfbuzz. Bounded, and flushed together with the
+    // live word caches on memory pressure.
+    struct RetainedWordCache {
+        RefPtr<gfxFontEntry> mFontEntry;
+        gfxFontStyle mStyle;
+        RefPtr<const gfxCharacterMap> mUnicodeRangeMap;
+        mozilla::UniquePtr<nsTHashtable<gfxFont::CacheHashEntry>> mWords;
+    };
+
     void AddSizeOfExcludingThis(mozilla::MallocSizeOf aMallocSizeOf,
                                 FontCacheSizes* aSizes) const;
     void AddSizeOfIncludingThis(mozilla::MallocSizeOf aMallocSizeOf,
@@ -426,6 +438,9 @@ protected:
 
     nsTHashtable<HashEntry> mFonts;
 
+    static const size_t kMaxRetainedWordCaches = 8;
+    nsTArray<RetainedWordCache> mRetainedWordCaches;
+
     static void WordCacheExpirationTimerCallback(nsITimer* aTimer, void* aCache);
     nsCOMPtr<nsITimer>      mWordCacheExpirationTimer;
 };
@@ -1916,6 +1931,7 @@ public:
         gfxFont* MOZ_NON_OWNING_REF mFont;
     };
     friend class GlyphChangeObserver;
+    friend class gfxFontCache;
 
     bool GlyphsMayChange()
     {
@@ -4,6 +4,8 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "WebRenderAPI.h"
+
+#include "GeckoProfiler.h"
 #include "LayersLogging.h"
 #include "mozilla/webrender/RendererOGL.h"
 #include "mozilla/gfx/gfxVars.h"
@@ -211,6 +213,7 @@ WebRenderAPI::UpdateScrollPosition(const wr::WrPipelineId& aPipelineId,
 void
 WebRenderAPI::GenerateFrame()
 {
+  mozilla::AutoProfilerTracing tracing("WebRender", "GenerateFrame");
   wr_api_generate_frame(mDocHandle);
 }
 
@@ -218,6 +221,7 @@ void
 WebRenderAPI::GenerateFrame(const nsTArray<wr::WrOpacityProperty>& aOpacityArray,
                             const nsTArray<wr::WrTransformProperty>& aTransformArray)
 {
+  mozilla::AutoProfilerTracing tracing("WebRender", "GenerateFrame");
   wr_api_generate_frame_with_properties(mDocHandle,
                                         aOpacityArray.IsEmpty() ?
                                           nullptr : aOpacityArray.Elements(),
@@ -238,6 +242,7 @@ WebRenderAPI::SetDisplayList(gfx::Color aBgColor,
                              size_t dl_size,
                              ResourceUpdateQueue& aResources)
 {
+  mozilla::AutoProfilerTracing tracing("WebRender", "SetDisplayList");
   wr_api_set_display_list(mDocHandle,
                           ToColorF(aBgColor),
                           aEpoch,
@@ -475,6 +475,32 @@ SourceBuffer::AppendFromInputStream(nsIInputStream* aInputStream,
   return rv;
 }
 
+nsresult
+SourceBuffer::CompleteWithAdoptedData(char* aData, size_t aLength,
+                                      AdoptedFreeFn aFreeData,
+                                      nsresult aStatus)
+{
+  MutexAutoLock lock(mMutex);
+
+  if (MOZ_UNLIKELY(mStatus || mChunks.Length() != 0)) {
+    // The chunked streaming path has already been used; the caller must
+    // release the buffer itself since we never adopted it.
+    return NS_ERROR_ALREADY_INITIALIZED;
+  }
+
+  if (MOZ_UNLIKELY(!mChunks.AppendElement(Chunk(aData, aLength, aFreeData),
+                                          fallible))) {
+    return NS_ERROR_OUT_OF_MEMORY;
+  }
+
+  mStatus = Some(aStatus);
+
+  // Resume any waiting consumers now that we're complete.
+  ResumeWaitingConsumers();
+
+  return NS_OK;
+}
+
 void
 SourceBuffer::Complete(nsresult aStatus)
 {
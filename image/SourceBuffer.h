@@ -328,6 +328,20 @@ public:
    */
   nsresult ExpectLength(size_t aExpectedLength);
 
+  /** Releases an adopted buffer; see CompleteWithAdoptedData. */
+  typedef void (*AdoptedFreeFn)(char* aData, size_t aCapacity);
+
+  /**
+   * Provide the complete encoded data as one externally owned buffer (for
+   * example an mmap of a local file or cache entry), adopted without
+   * copying; aFreeData releases it when the SourceBuffer dies. Marks the
+   * buffer complete with aStatus. Fails if data has already been appended
+   * through the chunked API.
+   */
+  nsresult CompleteWithAdoptedData(char* aData, size_t aLength,
+                                   AdoptedFreeFn aFreeData,
+                                   nsresult aStatus);
+
   /// Append the provided data to the buffer.
   nsresult Append(const char* aData, size_t aLength);
 
@@ -382,23 +396,44 @@ private:
   class Chunk final
   {
   public:
+    // Frees a chunk's data; malloc'd chunks use free(), externally provided
+    // (e.g. memory-mapped) chunks supply their own release function.
+    typedef void (*FreeDataFn)(char* aData, size_t aCapacity);
+
     explicit Chunk(size_t aCapacity)
       : mCapacity(aCapacity)
       , mLength(0)
+      , mFreeData(FreeMallocedData)
     {
       MOZ_ASSERT(aCapacity > 0, "Creating zero-capacity chunk");
       mData = static_cast<char*>(malloc(mCapacity));
     }
 
+    // Adopt an externally owned, already-filled buffer (for example a memory
+    // mapping of a local or cache file) without copying it. Such a chunk is
+    // immutable: it cannot be grown with SetCapacity.
+    Chunk(char* aData, size_t aLength, FreeDataFn aFreeData)
+      : mCapacity(aLength)
+      , mLength(aLength)
+      , mData(aData)
+      , mFreeData(aFreeData)
+    {
+      MOZ_ASSERT(aData);
+      MOZ_ASSERT(aFreeData);
+    }
+
     ~Chunk()
     {
-      free(mData);
+      if (mData) {
+        mFreeData(mData, mCapacity);
+      }
     }
 
     Chunk(Chunk&& aOther)
       : mCapacity(aOther.mCapacity)
       , mLength(aOther.mLength)
       , mData(aOther.mData)
+      , mFreeData(aOther.mFreeData)
     {
       aOther.mCapacity = aOther.mLength = 0;
       aOther.mData = nullptr;
@@ -406,10 +441,13 @@ private:
 
     Chunk& operator=(Chunk&& aOther)
     {
-      free(mData);
+      if (mData) {
+        mFreeData(mData, mCapacity);
+      }
       mCapacity = aOther.mCapacity;
       mLength = aOther.mLength;
       mData = aOther.mData;
+      mFreeData = aOther.mFreeData;
       aOther.mCapacity = aOther.mLength = 0;
       aOther.mData = nullptr;
       return *this;
@@ -434,6 +472,8 @@ private:
     bool SetCapacity(size_t aCapacity)
     {
       MOZ_ASSERT(mData, "Allocation failed but nobody checked for it");
+      MOZ_ASSERT(mFreeData == FreeMallocedData,
+                 "Can't reallocate an adopted chunk");
       char* data = static_cast<char*>(realloc(mData, aCapacity));
       if (!data) {
         return false;
@@ -444,13 +484,18 @@ private:
       return true;
     }
 
+    bool IsAdopted() const { return mFreeData != FreeMallocedData; }
+
   private:
+    static void FreeMallocedData(char* aData, size_t) { free(aData); }
+
     Chunk(const Chunk&) = delete;
     Chunk& operator=(const Chunk&) = delete;
 
     size_t mCapacity;
     size_t mLength;
     char* mData;
+    FreeDataFn mFreeData;
   };
 
   nsresult AppendChunk(Maybe<Chunk>&& aChunk);
@@ -7,8 +7,14 @@
 
 #include "nsJISx4051LineBreaker.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LINE_BREAKER_SSE2 1
+#include <emmintrin.h>
+#endif
+
 #include "jisx4051class.h"
 #include "nsComplexBreaker.h"
+#include "mozilla/MathAlgorithms.h"
 #include "nsTArray.h"
 #include "nsUnicodeProperties.h"
 
@@ -638,6 +644,11 @@ public:
     ++mIndex;
   }
 
+  void AdvanceIndexTo(uint32_t aIndex) {
+    MOZ_ASSERT(aIndex >= mIndex);
+    mIndex = aIndex;
+  }
+
   void NotifyBreakBefore() { mLastBreakIndex = mIndex; }
 
 // A word of western language should not be broken. But even if the word has
@@ -942,6 +953,74 @@ nsJISx4051LineBreaker::Prev(const char16_t* aText, uint32_t aLen,
   return prevPos > 0 ? prevPos : NS_LINEBREAKER_NEED_MORE_TEXT;
 }
 
+
+// Fast-path scanning for runs of plain ASCII alphanumerics. Inside such a
+// run no contextual analysis is needed, every character has the same break
+// class, and neither the normal nor the conservative pair table allows a
+// break between two of them, so the caller can classify the whole run in
+// one step. The scans go a vector register at a time where SSE2 is
+// available.
+
+template<typename CharT>
+static inline bool
+IsPlainAlnumAscii(CharT aCh)
+{
+  return (aCh >= '0' && aCh <= '9') ||
+         (aCh >= 'A' && aCh <= 'Z') ||
+         (aCh >= 'a' && aCh <= 'z');
+}
+
+#ifdef LINE_BREAKER_SSE2
+static inline uint32_t
+NonAlnumMask(const uint8_t* aChars)
+{
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aChars));
+  __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+  __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+  __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('a' - 1)),
+                                _mm_cmplt_epi8(v, _mm_set1_epi8('z' + 1)));
+  __m128i alnum = _mm_or_si128(_mm_or_si128(digit, upper), lower);
+  return ~_mm_movemask_epi8(alnum) & 0xFFFF;
+}
+
+static inline uint32_t
+NonAlnumMask(const char16_t* aChars)
+{
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aChars));
+  __m128i digit = _mm_and_si128(_mm_cmpgt_epi16(v, _mm_set1_epi16('0' - 1)),
+                                _mm_cmplt_epi16(v, _mm_set1_epi16('9' + 1)));
+  __m128i upper = _mm_and_si128(_mm_cmpgt_epi16(v, _mm_set1_epi16('A' - 1)),
+                                _mm_cmplt_epi16(v, _mm_set1_epi16('Z' + 1)));
+  __m128i lower = _mm_and_si128(_mm_cmpgt_epi16(v, _mm_set1_epi16('a' - 1)),
+                                _mm_cmplt_epi16(v, _mm_set1_epi16('z' + 1)));
+  __m128i alnum = _mm_or_si128(_mm_or_si128(digit, upper), lower);
+  return ~_mm_movemask_epi8(alnum) & 0xFFFF;
+}
+#endif
+
+template<typename CharT>
+static uint32_t
+FindAlnumRunEnd(const CharT* aChars, uint32_t aStart, uint32_t aLength)
+{
+  uint32_t i = aStart;
+#ifdef LINE_BREAKER_SSE2
+  const uint32_t charsPerVector = 16 / sizeof(CharT);
+  while (aLength - i >= charsPerVector) {
+    uint32_t mask = NonAlnumMask(aChars + i);
+    if (mask) {
+      return i + mozilla::CountTrailingZeroes32(mask) / sizeof(CharT);
+    }
+    i += charsPerVector;
+  }
+#endif
+  while (i < aLength && IsPlainAlnumAscii(aChars[i])) {
+    ++i;
+  }
+  return i;
+}
+
 void
 nsJISx4051LineBreaker::GetJISx4051Breaks(const char16_t* aChars, uint32_t aLength,
                                          uint8_t aWordBreak,
@@ -997,6 +1076,20 @@ nsJISx4051LineBreaker::GetJISx4051Breaks(const char16_t* aChars, uint32_t aLengt
     if (allowBreak)
       state.NotifyBreakBefore();
     lastClass = cl;
+
+    // Bulk-classify any following run of plain ASCII alphanumerics; see
+    // FindAlnumRunEnd above. BreakAll must keep the per-character path.
+    if (aWordBreak == nsILineBreaker::kWordBreak_Normal &&
+        IsPlainAlnumAscii(ch)) {
+      uint32_t runEnd = FindAlnumRunEnd(aChars, cur + 1, aLength);
+      if (runEnd > cur + 1) {
+        memset(aBreakBefore + cur + 1, 0, runEnd - (cur + 1));
+        state.NotifyNonHyphenCharacter(aChars[runEnd - 1]);
+        state.AdvanceIndexTo(runEnd - 1);
+        cur = runEnd - 1;
+      }
+    }
+
     if (CLASS_COMPLEX == cl) {
       uint32_t end = cur + chLen;
 
@@ -1075,5 +1168,18 @@ nsJISx4051LineBreaker::GetJISx4051Breaks(const uint8_t* aChars, uint32_t aLength
     if (allowBreak)
       state.NotifyBreakBefore();
     lastClass = cl;
+
+    // Bulk-classify any following run of plain ASCII alphanumerics; see
+    // FindAlnumRunEnd above. BreakAll must keep the per-character path.
+    if (aWordBreak == nsILineBreaker::kWordBreak_Normal &&
+        IsPlainAlnumAscii(ch)) {
+      uint32_t runEnd = FindAlnumRunEnd(aChars, cur + 1, aLength);
+      if (runEnd > cur + 1) {
+        memset(aBreakBefore + cur + 1, 0, runEnd - (cur + 1));
+        state.NotifyNonHyphenCharacter(aChars[runEnd - 1]);
+        state.AdvanceIndexTo(runEnd - 1);
+        cur = runEnd - 1;
+      }
+    }
   }
 }
@@ -639,6 +639,32 @@ bool Pickle::WriteBytes(const void* data, uint32_t data_len, uint32_t alignment)
   return true;
 }
 
+bool Pickle::WriteBytesZeroCopy(void* data, uint32_t data_len, size_t capacity) {
+  DCHECK(data_len % 8 == 0);
+  DCHECK(capacity % 8 == 0);
+  DCHECK(intptr_t(header_) % 8 == 0);
+
+  if (data_len < kZeroCopyThreshold) {
+    bool ok = WriteBytes(data, data_len, 8);
+    free(data);
+    return ok;
+  }
+
+  // Align the payload to 8 so the spliced segment preserves the BufferList
+  // alignment property; since data_len is a multiple of 8, no trailing
+  // padding is needed and writes after the splice start a fresh segment.
+  BeginWrite(data_len, 8);
+
+  if (!buffers_.WriteBytesZeroCopy(reinterpret_cast<char*>(data), data_len,
+                                   capacity)) {
+    free(data);
+    return false;
+  }
+
+  EndWrite(data_len);
+  return true;
+}
+
 bool Pickle::WriteString(const std::string& value) {
 #ifdef FUZZING
   std::string v(value);
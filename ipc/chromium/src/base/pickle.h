@@ -162,6 +162,15 @@ class Pickle {
   bool WriteData(const char* data, uint32_t length);
   bool WriteBytes(const void* data, uint32_t data_len,
                   uint32_t alignment = sizeof(memberAlignmentType));
+  // Hand an owned, malloc'd buffer to the message without copying. data_len
+  // and capacity must be multiples of 8 (e.g. structured clone data), and
+  // ownership passes to the Pickle even on failure. Small buffers below
+  // kZeroCopyThreshold are copied instead, since splicing a segment costs
+  // more than a short memcpy.
+  bool WriteBytesZeroCopy(void* data, uint32_t data_len, size_t capacity);
+
+  // Buffers smaller than this are copied rather than spliced.
+  static const uint32_t kZeroCopyThreshold = 64 * 1024;
 
   bool WriteSentinel(uint32_t sentinel)
 #ifdef MOZ_PICKLE_SENTINEL_CHECKING
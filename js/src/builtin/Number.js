@@ -31,6 +31,16 @@ function Number_toLocaleString() {
         if (numberFormatCache.numberFormat === undefined)
             numberFormatCache.numberFormat = intl_NumberFormat(locales, options);
         numberFormat = numberFormatCache.numberFormat;
+    } else if (typeof locales === "string" && options === undefined) {
+        // Grids and tables re-resolve the same explicit locale thousands of
+        // times; remember the last single-locale, default-options format.
+        // Constructing the Intl.NumberFormat (and its ICU formatter) is the
+        // dominant cost of this function.
+        if (numberFormatCache.lastLocale !== locales) {
+            numberFormatCache.lastLocaleFormat = intl_NumberFormat(locales, options);
+            numberFormatCache.lastLocale = locales;
+        }
+        numberFormat = numberFormatCache.lastLocaleFormat;
     } else {
         numberFormat = intl_NumberFormat(locales, options);
     }
@@ -981,6 +981,16 @@ js::Nursery::maybeResizeNursery(JS::gcreason::Reason reason)
         return;
     }
 
+    // A workload that went dormant stops doing minor GCs, so the usual
+    // promotion-rate shrinking below never runs and a nursery grown during a
+    // busy phase pins its chunks indefinitely. User-inactive and shrinking
+    // collections release everything beyond the minimum instead.
+    if (reason == JS::gcreason::USER_INACTIVE ||
+        reason == JS::gcreason::SET_DOC_SHELL) {
+        minimizeAllocableSpace();
+        return;
+    }
+
 #ifdef JS_GC_ZEAL
     // This zeal mode disabled nursery resizing.
     if (runtime()->hasZealMode(ZealMode::GenerationalGC))
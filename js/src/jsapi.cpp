@@ -73,6 +73,7 @@
 #include "js/Utility.h"
 #include "vm/AsyncFunction.h"
 #include "vm/AsyncIteration.h"
+#include "vm/BytecodeCache.h"
 #include "vm/DateObject.h"
 #include "vm/Debugger.h"
 #include "vm/EnvironmentObject.h"
@@ -4078,8 +4079,29 @@ Compile(JSContext* cx, const ReadOnlyCompileOptions& options, ScopeKind scopeKin
     AssertHeapIsIdle();
     CHECK_REQUEST(cx);
 
+    // Consult the embedder's bytecode cache, if any, before running the
+    // frontend. Restricted to global scripts: the non-syntactic scope chain
+    // is not captured by the cache key.
+    const JS::ScriptBytecodeCacheOps& cacheOps = cx->runtime()->scriptBytecodeCacheOps.ref();
+    bool consultCache = (cacheOps.lookup || cacheOps.store) &&
+                        scopeKind == ScopeKind::Global &&
+                        srcBuf.length() >= MinimumCacheableSourceLength;
+    uint64_t cacheKey = 0;
+    if (consultCache) {
+        cacheKey = ScriptBytecodeCacheKey(options, srcBuf.get(), srcBuf.length());
+        if (!LookupCachedScriptBytecode(cx, cacheKey, script))
+            return false;
+        if (script)
+            return true;
+    }
+
     script.set(frontend::CompileGlobalScript(cx, cx->tempLifoAlloc(), scopeKind, options, srcBuf));
-    return !!script;
+    if (!script)
+        return false;
+
+    if (consultCache)
+        StoreScriptBytecode(cx, cacheKey, script);
+    return true;
 }
 
 static bool
@@ -4360,6 +4382,29 @@ JS::CancelMultiOffThreadScriptsDecoder(JSContext* cx, void* token)
     HelperThreadState().cancelParseTask(cx->runtime(), ParseTaskKind::MultiScriptsDecode, token);
 }
 
+JS_PUBLIC_API(bool)
+JS::ParseJSONOffThread(JSContext* cx, const char16_t* chars, size_t length,
+                       OffThreadCompileCallback callback, void* callbackData)
+{
+    return StartOffThreadParseJSON(cx, chars, length, callback, callbackData);
+}
+
+JS_PUBLIC_API(bool)
+JS::FinishOffThreadJSONParse(JSContext* cx, void* token, MutableHandleValue result)
+{
+    MOZ_ASSERT(cx);
+    MOZ_ASSERT(CurrentThreadCanAccessRuntime(cx->runtime()));
+    return HelperThreadState().finishJSONParseTask(cx, token, result);
+}
+
+JS_PUBLIC_API(void)
+JS::CancelOffThreadJSONParse(JSContext* cx, void* token)
+{
+    MOZ_ASSERT(cx);
+    MOZ_ASSERT(CurrentThreadCanAccessRuntime(cx->runtime()));
+    HelperThreadState().cancelParseTask(cx->runtime(), ParseTaskKind::JSONParse, token);
+}
+
 JS_PUBLIC_API(bool)
 JS_CompileScript(JSContext* cx, const char* ascii, size_t length,
                  const JS::CompileOptions& options, MutableHandleScript script)
@@ -7622,6 +7667,13 @@ JS::SetAsmJSCacheOps(JSContext* cx, const JS::AsmJSCacheOps* ops)
     cx->runtime()->asmJSCacheOps = *ops;
 }
 
+JS_PUBLIC_API(void)
+JS::SetScriptBytecodeCacheOps(JSContext* cx, const JS::ScriptBytecodeCacheOps* ops, void* data)
+{
+    cx->runtime()->scriptBytecodeCacheOps = *ops;
+    cx->runtime()->scriptBytecodeCacheData = data;
+}
+
 bool
 JS::IsWasmModuleObject(HandleObject obj)
 {
@@ -4464,6 +4464,24 @@ FinishMultiOffThreadScriptsDecoder(JSContext* cx, void* token, JS::MutableHandle
 extern JS_PUBLIC_API(void)
 CancelMultiOffThreadScriptsDecoder(JSContext* cx, void* token);
 
+/*
+ * Off-thread JSON parsing for large payloads. The text is tokenized and the
+ * object graph is built on a helper thread in a separate zone, which is then
+ * merged into the current compartment by FinishOffThreadJSONParse; no
+ * per-node materialization work remains on the calling thread. The usual
+ * off-thread callback protocol applies, and the characters must remain live
+ * until the callback is invoked.
+ */
+extern JS_PUBLIC_API(bool)
+ParseJSONOffThread(JSContext* cx, const char16_t* chars, size_t length,
+                   OffThreadCompileCallback callback, void* callbackData);
+
+extern JS_PUBLIC_API(bool)
+FinishOffThreadJSONParse(JSContext* cx, void* token, MutableHandleValue result);
+
+extern JS_PUBLIC_API(void)
+CancelOffThreadJSONParse(JSContext* cx, void* token);
+
 /**
  * Compile a function with envChain plus the global as its scope chain.
  * envChain must contain objects in the current compartment of cx.  The actual
@@ -6427,6 +6445,42 @@ StartIncrementalEncoding(JSContext* cx, JS::HandleScript script);
 extern JS_PUBLIC_API(bool)
 FinishIncrementalEncoding(JSContext* cx, JS::HandleScript script, TranscodeBuffer& buffer);
 
+/*
+ * This callback represents a request by the JS engine to look up a previously
+ * stored XDR encoding of a script about to be compiled. The |key| is a hash of
+ * the source characters and of the compile options which affect the generated
+ * bytecode; the embedder is expected to mix in its buildId when addressing any
+ * persistent storage. On a hit, the callback shall return 'true' and fill
+ * |buffer| with the stored bytes. Returning 'false' (with |buffer| empty) is
+ * not an error and simply causes a regular compile.
+ */
+typedef bool
+(* ScriptBytecodeCacheLookupOp)(uint64_t key, TranscodeBuffer& buffer, void* data);
+
+/*
+ * This callback notifies the embedder of the XDR encoding of a script which
+ * has just been compiled, so that it may be stored and returned by a later
+ * ScriptBytecodeCacheLookupOp call with the same |key|. The buffer is only
+ * valid for the duration of the call.
+ */
+typedef void
+(* ScriptBytecodeCacheStoreOp)(uint64_t key, const TranscodeBuffer& buffer, void* data);
+
+struct ScriptBytecodeCacheOps
+{
+    ScriptBytecodeCacheLookupOp lookup;
+    ScriptBytecodeCacheStoreOp store;
+};
+
+/*
+ * Register runtime-wide hooks consulted by the JS::Compile entry points
+ * before the frontend runs. The engine computes the key and performs the
+ * XDR encoding and decoding; the embedder owns the storage, including any
+ * disk I/O and eviction policy.
+ */
+extern JS_PUBLIC_API(void)
+SetScriptBytecodeCacheOps(JSContext* cx, const ScriptBytecodeCacheOps* ops, void* data);
+
 } /* namespace JS */
 
 namespace js {
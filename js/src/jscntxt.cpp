@@ -1551,6 +1551,9 @@ JSContext::trace(JSTracer* trc)
     cycleDetectorVector().trace(trc);
     geckoProfiler().trace(trc);
 
+    for (JSString*& str : pendingRopeFlattens())
+        js::TraceRoot(trc, &str, "pending rope flatten");
+
     if (trc->isMarkingTracer() && compartment_)
         compartment_->mark();
 }
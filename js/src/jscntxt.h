@@ -671,6 +671,20 @@ struct JSContext : public JS::RootingContext,
         return cycleDetectorVector_.ref();
     }
 
+  private:
+    /*
+     * Large ropes noted at concatenation time so that an embedder-driven idle
+     * pass (JS::FlattenPendingRopes) can flatten them before first use, off
+     * the critical path. Entries are strong roots until drained, so the list
+     * is kept short and opportunistic.
+     */
+    js::ThreadLocalData<js::Vector<JSString*, 0, js::SystemAllocPolicy>> pendingRopeFlattens_;
+
+  public:
+    js::Vector<JSString*, 0, js::SystemAllocPolicy>& pendingRopeFlattens() {
+        return pendingRopeFlattens_.ref();
+    }
+
     /* Client opaque pointer. */
     js::UnprotectedData<void*> data;
 
@@ -25,6 +25,7 @@
 #include "js/Proxy.h"
 #include "proxy/DeadObjectProxy.h"
 #include "vm/ArgumentsObject.h"
+#include "vm/HelperThreads.h"
 #include "vm/Time.h"
 #include "vm/WrapperObject.h"
 
@@ -640,6 +641,29 @@ js::StringToLinearStringSlow(JSContext* cx, JSString* str)
     return str->ensureLinear(cx);
 }
 
+JS_FRIEND_API(void)
+js::FlattenPendingRopes(JSContext* cx)
+{
+    auto& pending = cx->pendingRopeFlattens();
+    while (!pending.empty()) {
+        JSString* str = pending.popCopy();
+        if (!str->isRope())
+            continue;
+        if (!str->ensureLinear(cx))
+            cx->recoverFromOutOfMemory();
+    }
+}
+
+JS_FRIEND_API(void)
+js::GetHelperThreadDispatchCounts(uint64_t* counts, size_t length)
+{
+    MOZ_RELEASE_ASSERT(length >= js::THREAD_TYPE_MAX);
+
+    AutoLockHelperThreadState lock;
+    for (size_t i = 0; i < js::THREAD_TYPE_MAX; i++)
+        counts[i] = HelperThreadState().dispatchedCount(js::ThreadType(i), lock);
+}
+
 JS_FRIEND_API(void)
 JS_SetAccumulateTelemetryCallback(JSContext* cx, JSAccumulateTelemetryDataCallback callback)
 {
@@ -904,6 +904,24 @@ IsExternalString(JSString* str, const JSStringFinalizer** fin, const char16_t**
 JS_FRIEND_API(JSLinearString*)
 StringToLinearStringSlow(JSContext* cx, JSString* str);
 
+/*
+ * Flatten any large ropes noted at concatenation time. Intended to be called
+ * from idle-time code so first-use flattening pauses move off the critical
+ * path; failures are swallowed and the normal lazy flatten remains the
+ * fallback.
+ */
+JS_FRIEND_API(void)
+FlattenPendingRopes(JSContext* cx);
+
+/*
+ * Fill |counts| (indexed by js::ThreadType, |length| at least
+ * js::THREAD_TYPE_MAX) with the cumulative number of helper thread tasks
+ * dispatched per kind, for telemetry. Wasm tier-2 batch compiles are
+ * accounted under THREAD_TYPE_WASM_TIER2.
+ */
+JS_FRIEND_API(void)
+GetHelperThreadDispatchCounts(uint64_t* counts, size_t length);
+
 MOZ_ALWAYS_INLINE JSLinearString*
 StringToLinearString(JSContext* cx, JSString* str)
 {
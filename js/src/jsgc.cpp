@@ -3883,6 +3883,8 @@ GCRuntime::purgeRuntime(AutoLockForExclusiveAccess& lock)
 
     rt->caches().gsnCache.purge();
     rt->caches().envCoordinateNameCache.purge();
+    rt->caches().interpreterGetPropCache.purge();
+    rt->caches().megamorphicSlotCache.purge();
     rt->caches().newObjectCache.purge();
     rt->caches().uncompressedSourceCache.purge();
     if (rt->caches().evalCache.initialized())
@@ -4174,6 +4176,48 @@ UnmarkCollectedZones(JSRuntime* rt)
     }
 }
 
+typedef Vector<Zone*, 8, SystemAllocPolicy> ZoneUnmarkVector;
+
+/*
+ * Unmark the collected zones on several helper threads at once. Zones are
+ * handed out through an atomic cursor rather than partitioned up front so
+ * that the work balances even when zone sizes are heavily skewed.
+ */
+class MOZ_RAII ParallelUnmarkTask : public GCParallelTask
+{
+    ZoneUnmarkVector& zones_;
+    mozilla::Atomic<size_t>& cursor_;
+    AutoLockHelperThreadState& lock_;
+
+  public:
+    ParallelUnmarkTask(JSRuntime* rt, ZoneUnmarkVector& zones,
+                       mozilla::Atomic<size_t>& cursor,
+                       AutoLockHelperThreadState& lock)
+      : GCParallelTask(rt),
+        zones_(zones),
+        cursor_(cursor),
+        lock_(lock)
+    {
+        runtime()->gc.startTask(*this, gcstats::PhaseKind::UNMARK, lock_);
+    }
+
+    ~ParallelUnmarkTask() {
+        runtime()->gc.joinTask(*this, gcstats::PhaseKind::UNMARK, lock_);
+    }
+
+    void run() override {
+        for (;;) {
+            size_t index = cursor_++;
+            if (index >= zones_.length())
+                break;
+
+            Zone* zone = zones_[index];
+            zone->arenas.unmarkAll();
+            WeakMapBase::unmarkZone(zone);
+        }
+    }
+};
+
 static void
 BufferGrayRoots(JSRuntime* rt)
 {
@@ -4209,11 +4253,33 @@ GCRuntime::beginMarkPhase(JS::gcreason::Reason reason, AutoLockForExclusiveAcces
 
         /*
          * Clear all mark state for the zones we are collecting. This is linear
-         * in the size of the heap we are collecting and so can be slow. Do this
-         * in parallel with the rest of this block.
+         * in the size of the heap we are collecting and so can be slow. Shard
+         * the zones over several helper tasks, run in parallel with the rest
+         * of this block.
          */
-        AutoRunParallelTask
-            unmarkCollectedZones(rt, UnmarkCollectedZones, gcstats::PhaseKind::UNMARK, helperLock);
+        ZoneUnmarkVector zonesToUnmark;
+        mozilla::Atomic<size_t> unmarkCursor(0);
+        bool gatheredZones = true;
+        for (GCZonesIter zone(rt); !zone.done(); zone.next()) {
+            if (!zonesToUnmark.append(zone)) {
+                gatheredZones = false;
+                break;
+            }
+        }
+
+        static const size_t MaxUnmarkTasks = 8;
+        Maybe<ParallelUnmarkTask> unmarkTasks[MaxUnmarkTasks];
+        if (gatheredZones) {
+            size_t numTasks = Min(zonesToUnmark.length(),
+                                  Min(HelperThreadState().cpuCount, MaxUnmarkTasks));
+            for (size_t i = 0; i < numTasks; i++)
+                unmarkTasks[i].emplace(rt, zonesToUnmark, unmarkCursor, helperLock);
+        } else {
+            /* OOM while gathering the zone list: unmark on this thread. */
+            AutoUnlockHelperThreadState unlock(helperLock);
+            gcstats::AutoPhase ap(stats(), gcstats::PhaseKind::UNMARK);
+            UnmarkCollectedZones(rt);
+        }
 
         /*
          * Buffer gray roots for incremental collections. This is linear in the
@@ -6453,6 +6519,8 @@ GCRuntime::compactPhase(JS::gcreason::Reason reason, SliceBudget& sliceBudget,
 
     // Clear caches that can contain cell pointers.
     rt->caches().newObjectCache.purge();
+    rt->caches().interpreterGetPropCache.purge();
+    rt->caches().megamorphicSlotCache.purge();
     if (rt->caches().evalCache.initialized())
         rt->caches().evalCache.clear();
 
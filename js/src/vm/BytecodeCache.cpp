@@ -0,0 +1,90 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ * vim: set ts=8 sts=4 et sw=4 tw=99:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "vm/BytecodeCache.h"
+
+#include "mozilla/HashFunctions.h"
+
+#include "jscntxt.h"
+
+#include "vm/Runtime.h"
+
+using namespace js;
+
+using mozilla::AddToHash;
+using mozilla::HashString;
+
+uint64_t
+js::ScriptBytecodeCacheKey(const JS::ReadOnlyCompileOptions& options,
+                           const char16_t* chars, size_t length)
+{
+    uint32_t sourceHash = HashString(chars, length);
+
+    // Mix in every option which changes the bytecode XDR produces or the
+    // semantics of running it. The filename and line are baked into the
+    // encoding (they surface in stacks), so they are part of the key too.
+    // Embedders are expected to additionally key their storage on the
+    // buildId, which DecodeScript re-checks anyway.
+    uint32_t optionsHash = AddToHash(0, unsigned(options.version),
+                                     options.selfHostingMode,
+                                     options.strictOption,
+                                     options.extraWarningsOption,
+                                     options.forEachStatementOption,
+                                     options.werrorOption,
+                                     options.noScriptRval,
+                                     // mutedErrors is baked into the script
+                                     // and gates cross-origin error
+                                     // sanitization; sharing entries across
+                                     // it would leak error details.
+                                     options.mutedErrors());
+    optionsHash = AddToHash(optionsHash, length, options.lineno, options.column);
+    if (options.filename())
+        optionsHash = AddToHash(optionsHash, HashString(options.filename()));
+
+    return (uint64_t(sourceHash) << 32) | optionsHash;
+}
+
+bool
+js::LookupCachedScriptBytecode(JSContext* cx, uint64_t key, JS::MutableHandleScript script)
+{
+    script.set(nullptr);
+
+    const JS::ScriptBytecodeCacheOps& ops = cx->runtime()->scriptBytecodeCacheOps.ref();
+    if (!ops.lookup)
+        return true;
+
+    JS::TranscodeBuffer buffer;
+    if (!ops.lookup(key, buffer, cx->runtime()->scriptBytecodeCacheData) || buffer.empty())
+        return true;
+
+    JS::TranscodeResult result = JS::DecodeScript(cx, buffer, script);
+    if (result == JS::TranscodeResult_Throw)
+        return false;
+    if (result != JS::TranscodeResult_Ok) {
+        // A stale or truncated entry (e.g. wrong buildId) is treated as a
+        // miss; the compile below will overwrite it.
+        script.set(nullptr);
+    }
+    return true;
+}
+
+void
+js::StoreScriptBytecode(JSContext* cx, uint64_t key, JS::HandleScript script)
+{
+    const JS::ScriptBytecodeCacheOps& ops = cx->runtime()->scriptBytecodeCacheOps.ref();
+    if (!ops.store)
+        return;
+
+    JS::TranscodeBuffer buffer;
+    if (JS::EncodeScript(cx, buffer, script) != JS::TranscodeResult_Ok) {
+        // Some scripts cannot be encoded (e.g. run-once lambdas); caching is
+        // strictly best-effort, so drop any pending exception and move on.
+        cx->clearPendingException();
+        return;
+    }
+
+    ops.store(key, buffer, cx->runtime()->scriptBytecodeCacheData);
+}
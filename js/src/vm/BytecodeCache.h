@@ -0,0 +1,49 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+ * vim: set ts=8 sts=4 et sw=4 tw=99:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef vm_BytecodeCache_h
+#define vm_BytecodeCache_h
+
+#include "jsapi.h"
+
+namespace js {
+
+/*
+ * Support for the embedder-backed script bytecode cache registered with
+ * JS::SetScriptBytecodeCacheOps. The engine computes a key from the source
+ * characters and the bytecode-affecting compile options, and performs the
+ * XDR encoding and decoding; the embedder owns the storage.
+ */
+
+/*
+ * Sources shorter than this are not worth a cache round-trip: the XDR
+ * overhead rivals the parse itself.
+ */
+static const size_t MinimumCacheableSourceLength = 1024;
+
+extern uint64_t
+ScriptBytecodeCacheKey(const JS::ReadOnlyCompileOptions& options,
+                       const char16_t* chars, size_t length);
+
+/*
+ * Consult the embedder's cache for a script matching |key|. Returns false on
+ * OOM or if decoding threw; otherwise returns true, with |script| left null
+ * on a cache miss or a stale (e.g. wrong buildId) entry.
+ */
+extern bool
+LookupCachedScriptBytecode(JSContext* cx, uint64_t key, JS::MutableHandleScript script);
+
+/*
+ * Hand the XDR encoding of a freshly compiled script to the embedder's cache.
+ * Best-effort: encoding failures are swallowed and the compile result is
+ * unaffected.
+ */
+extern void
+StoreScriptBytecode(JSContext* cx, uint64_t key, JS::HandleScript script);
+
+} // namespace js
+
+#endif /* vm_BytecodeCache_h */
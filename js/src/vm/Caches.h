@@ -7,6 +7,8 @@
 #ifndef vm_Caches_h
 #define vm_Caches_h
 
+#include "mozilla/PodOperations.h"
+
 #include "jsatom.h"
 #include "jsbytecode.h"
 #include "jsmath.h"
@@ -244,6 +246,102 @@ class NewObjectCache
     }
 };
 
+/*
+ * Direct-mapped cache of monomorphic JSOP_GETPROP/JSOP_CALLPROP sites in the
+ * C++ interpreter. An entry records the receiver shape last seen at a given
+ * pc and the slot the name resolved to; a hit loads the slot directly and
+ * skips the generic lookup path. Entries hold weak Shape pointers, so the
+ * cache is purged whenever a GC may free or relocate shapes.
+ */
+class InterpreterGetPropCache
+{
+    static const size_t NumEntries = 256;
+
+    struct Entry {
+        jsbytecode* pc;
+        Shape* receiverShape;
+        uint32_t slot;
+    };
+
+    Entry entries_[NumEntries];
+
+    static size_t entryIndex(jsbytecode* pc) {
+        return (uintptr_t(pc) >> 2) & (NumEntries - 1);
+    }
+
+  public:
+    InterpreterGetPropCache() { purge(); }
+
+    MOZ_ALWAYS_INLINE bool lookup(jsbytecode* pc, Shape* receiverShape, uint32_t* slotOut) {
+        Entry& entry = entries_[entryIndex(pc)];
+        if (entry.pc != pc || entry.receiverShape != receiverShape)
+            return false;
+        *slotOut = entry.slot;
+        return true;
+    }
+
+    MOZ_ALWAYS_INLINE void fill(jsbytecode* pc, Shape* receiverShape, uint32_t slot) {
+        Entry& entry = entries_[entryIndex(pc)];
+        entry.pc = pc;
+        entry.receiverShape = receiverShape;
+        entry.slot = slot;
+    }
+
+    void purge() { mozilla::PodArrayZero(entries_); }
+};
+
+/*
+ * Runtime-wide cache for megamorphic property reads: sites whose receiver
+ * shapes overflow their CacheIR stubs fall into NativeGetProperty on every
+ * access, where this direct-mapped (shape, id) -> slot table catches the
+ * repeats. Entries follow the same rules as InterpreterGetPropCache: own
+ * plain data properties on non-dictionary shapes only, purged whenever the
+ * GC may free or move shapes or atoms.
+ */
+class MegamorphicSlotCache
+{
+    static const size_t NumEntries = 1024;
+
+    struct Entry {
+        Shape* shape;
+        jsid id;
+        uint32_t slot;
+    };
+
+    Entry entries_[NumEntries];
+
+    static size_t entryIndex(Shape* shape, jsid id) {
+        uintptr_t hash = uintptr_t(shape) ^ (JSID_BITS(id) >> 3);
+        return (hash ^ (hash >> 13)) & (NumEntries - 1);
+    }
+
+  public:
+    MegamorphicSlotCache() { purge(); }
+
+    MOZ_ALWAYS_INLINE bool lookup(Shape* shape, jsid id, uint32_t* slotOut) {
+        Entry& entry = entries_[entryIndex(shape, id)];
+        if (entry.shape != shape || entry.id != id)
+            return false;
+        *slotOut = entry.slot;
+        return true;
+    }
+
+    MOZ_ALWAYS_INLINE void fill(Shape* shape, jsid id, uint32_t slot) {
+        Entry& entry = entries_[entryIndex(shape, id)];
+        entry.shape = shape;
+        entry.id = id;
+        entry.slot = slot;
+    }
+
+    void purge() {
+        for (Entry& entry : entries_) {
+            entry.shape = nullptr;
+            entry.id = JSID_VOID;
+            entry.slot = 0;
+        }
+    }
+};
+
 class RuntimeCaches
 {
     UniquePtr<js::MathCache> mathCache_;
@@ -257,6 +355,8 @@ class RuntimeCaches
     js::UncompressedSourceCache uncompressedSourceCache;
     js::EvalCache evalCache;
     LazyScriptCache lazyScriptCache;
+    js::InterpreterGetPropCache interpreterGetPropCache;
+    js::MegamorphicSlotCache megamorphicSlotCache;
 
     bool init();
 
@@ -20,6 +20,7 @@
 #include "threading/CpuCount.h"
 #include "vm/Debugger.h"
 #include "vm/ErrorReporting.h"
+#include "vm/JSONParser.h"
 #include "vm/SharedImmutableStringsCache.h"
 #include "vm/Time.h"
 #include "vm/TraceLogging.h"
@@ -402,6 +403,7 @@ ParseTask::ParseTask(ParseTaskKind kind, JSContext* cx, JSObject* parseGlobal,
     parseGlobal(parseGlobal),
     callback(callback), callbackData(callbackData),
     scripts(cx), sourceObjects(cx),
+    jsonValue(JS::UndefinedValue()),
     overRecursed(false), outOfMemory(false)
 {
     MOZ_ALWAYS_TRUE(scripts.reserve(scripts.capacity()));
@@ -416,6 +418,7 @@ ParseTask::ParseTask(ParseTaskKind kind, JSContext* cx, JSObject* parseGlobal,
     parseGlobal(parseGlobal),
     callback(callback), callbackData(callbackData),
     scripts(cx), sourceObjects(cx),
+    jsonValue(JS::UndefinedValue()),
     overRecursed(false), outOfMemory(false)
 {
     MOZ_ALWAYS_TRUE(scripts.reserve(scripts.capacity()));
@@ -430,6 +433,7 @@ ParseTask::ParseTask(ParseTaskKind kind, JSContext* cx, JSObject* parseGlobal,
     parseGlobal(parseGlobal),
     callback(callback), callbackData(callbackData),
     scripts(cx), sourceObjects(cx),
+    jsonValue(JS::UndefinedValue()),
     overRecursed(false), outOfMemory(false)
 {
     MOZ_ALWAYS_TRUE(scripts.reserve(scripts.capacity()));
@@ -485,6 +489,7 @@ ParseTask::trace(JSTracer* trc)
     TraceManuallyBarrieredEdge(trc, &parseGlobal, "ParseTask::parseGlobal");
     scripts.trace(trc);
     sourceObjects.trace(trc);
+    TraceManuallyBarrieredEdge(trc, &jsonValue, "ParseTask::jsonValue");
 }
 
 ScriptParseTask::ScriptParseTask(JSContext* cx, JSObject* parseGlobal,
@@ -597,6 +602,30 @@ MultiScriptsDecodeTask::parse(JSContext* cx)
     }
 }
 
+JSONParseTask::JSONParseTask(JSContext* cx, JSObject* parseGlobal,
+                             const char16_t* chars, size_t length,
+                             JS::OffThreadCompileCallback callback, void* callbackData)
+  : ParseTask(ParseTaskKind::JSONParse, cx, parseGlobal, chars, length, callback,
+              callbackData)
+{
+}
+
+void
+JSONParseTask::parse(JSContext* cx)
+{
+    auto& range = data.as<TwoByteChars>();
+
+    RootedValue result(cx);
+    // Syntax errors cannot be turned into exception objects on a helper
+    // thread (the parse global has no Error constructor), so run with NoError
+    // handling and report a generic syntax error when finishing the task.
+    JSONParser<char16_t> parser(cx, mozilla::Range<const char16_t>(range.begin().get(),
+                                                                   range.length()),
+                                JSONParserBase::NoError);
+    if (parser.parse(&result))
+        jsonValue = result;
+}
+
 void
 js::CancelOffThreadParses(JSRuntime* rt)
 {
@@ -873,6 +902,17 @@ js::StartOffThreadDecodeMultiScripts(JSContext* cx, const ReadOnlyCompileOptions
     return StartOffThreadParseTask(cx, options, ParseTaskKind::MultiScriptsDecode, functor);
 }
 
+bool
+js::StartOffThreadParseJSON(JSContext* cx, const char16_t* chars, size_t length,
+                            JS::OffThreadCompileCallback callback, void* callbackData)
+{
+    auto functor = [&](JSObject* global) -> JSONParseTask* {
+        return cx->new_<JSONParseTask>(cx, global, chars, length, callback, callbackData);
+    };
+    JS::CompileOptions options(cx);
+    return StartOffThreadParseTask(cx, options, ParseTaskKind::JSONParse, functor);
+}
+
 void
 js::EnqueuePendingParseTasksAfterGC(JSRuntime* rt)
 {
@@ -979,6 +1019,9 @@ GlobalHelperThreadState::GlobalHelperThreadState()
    wasmTier2GeneratorsFinished_(0),
    helperLock(mutexid::GlobalHelperThreadState)
 {
+    mozilla::PodArrayZero(dispatchedCounts_);
+    mozilla::PodArrayZero(passedOverCounts_);
+
     cpuCount = ClampDefaultCPUCount(GetCPUCount());
     threadCount = ThreadCountForCPUCount(cpuCount);
 
@@ -1691,6 +1734,30 @@ GlobalHelperThreadState::finishModuleParseTask(JSContext* cx, void* token)
     return module;
 }
 
+bool
+GlobalHelperThreadState::finishJSONParseTask(JSContext* cx, void* token,
+                                             JS::MutableHandleValue result)
+{
+    result.setUndefined();
+
+    bool ok = finishParseTask(cx, ParseTaskKind::JSONParse, token, [&result] (ParseTask* parseTask) {
+        result.set(parseTask->jsonValue);
+        return true;
+    });
+
+    if (!ok)
+        return false;
+
+    // JSON cannot denote |undefined|, so an undefined result means the parse
+    // failed (out of memory is reported by finishParseTask above).
+    if (result.isUndefined()) {
+        JS_ReportErrorNumberASCII(cx, GetErrorMessage, nullptr, JSMSG_JSON_PARSE_FAILED);
+        return false;
+    }
+
+    return true;
+}
+
 void
 GlobalHelperThreadState::cancelParseTask(JSRuntime* rt, ParseTaskKind kind, void* token)
 {
@@ -2182,6 +2249,92 @@ JSContext::setHelperThread(HelperThread* thread)
     helperThread_ = thread;
 }
 
+js::ThreadType
+GlobalHelperThreadState::selectTask(wasm::CompileMode* tier, const AutoLockHelperThreadState& lock)
+{
+    // Task kinds in descending base priority. |counterSlot| is the ThreadType
+    // slot used for bookkeeping (wasm tier-2 batch compiles are accounted
+    // against THREAD_TYPE_WASM_TIER2 even though they execute as
+    // THREAD_TYPE_WASM tasks). |starvationLimit| bounds how many times a
+    // runnable kind may be passed over for higher-priority work before it is
+    // dispatched regardless; this keeps e.g. a wasm compile storm from
+    // starving the off-thread parses that gate page loads.
+    static const uint32_t NoLimit = UINT32_MAX;
+    struct Kind {
+        js::ThreadType type;
+        js::ThreadType counterSlot;
+        wasm::CompileMode wasmTier;
+        uint32_t starvationLimit;
+    };
+    static const Kind kinds[] = {
+        { js::THREAD_TYPE_GCPARALLEL, js::THREAD_TYPE_GCPARALLEL,
+          wasm::CompileMode::Once, NoLimit },
+        { js::THREAD_TYPE_GCHELPER, js::THREAD_TYPE_GCHELPER,
+          wasm::CompileMode::Once, NoLimit },
+        { js::THREAD_TYPE_ION, js::THREAD_TYPE_ION,
+          wasm::CompileMode::Once, 16 },
+        { js::THREAD_TYPE_WASM, js::THREAD_TYPE_WASM,
+          wasm::CompileMode::Tier1, 16 },
+        { js::THREAD_TYPE_PROMISE_TASK, js::THREAD_TYPE_PROMISE_TASK,
+          wasm::CompileMode::Once, 16 },
+        { js::THREAD_TYPE_PARSE, js::THREAD_TYPE_PARSE,
+          wasm::CompileMode::Once, 8 },
+        { js::THREAD_TYPE_COMPRESS, js::THREAD_TYPE_COMPRESS,
+          wasm::CompileMode::Once, 64 },
+        { js::THREAD_TYPE_ION_FREE, js::THREAD_TYPE_ION_FREE,
+          wasm::CompileMode::Once, 64 },
+        { js::THREAD_TYPE_WASM, js::THREAD_TYPE_WASM_TIER2,
+          wasm::CompileMode::Tier2, 64 },
+        { js::THREAD_TYPE_WASM_TIER2, js::THREAD_TYPE_WASM_TIER2,
+          wasm::CompileMode::Once, 64 },
+    };
+
+    auto canStart = [&](const Kind& kind) {
+        switch (kind.type) {
+          case js::THREAD_TYPE_GCPARALLEL:   return canStartGCParallelTask(lock);
+          case js::THREAD_TYPE_GCHELPER:     return canStartGCHelperTask(lock);
+          case js::THREAD_TYPE_ION:          return canStartIonCompile(lock);
+          case js::THREAD_TYPE_WASM:         return canStartWasmCompile(lock, kind.wasmTier);
+          case js::THREAD_TYPE_PROMISE_TASK: return canStartPromiseHelperTask(lock);
+          case js::THREAD_TYPE_PARSE:        return canStartParseTask(lock);
+          case js::THREAD_TYPE_COMPRESS:     return canStartCompressionTask(lock);
+          case js::THREAD_TYPE_ION_FREE:     return canStartIonFreeTask(lock);
+          case js::THREAD_TYPE_WASM_TIER2:   return canStartWasmTier2Generator(lock);
+          default:                           MOZ_CRASH("bad helper task kind");
+        }
+    };
+
+    // A runnable kind that has exhausted its starvation allowance runs first;
+    // otherwise the first runnable kind in priority order wins.
+    const Kind* selected = nullptr;
+    for (const Kind& kind : kinds) {
+        if (passedOverCounts_[kind.counterSlot] >= kind.starvationLimit && canStart(kind)) {
+            selected = &kind;
+            break;
+        }
+    }
+    if (!selected) {
+        for (const Kind& kind : kinds) {
+            if (canStart(kind)) {
+                selected = &kind;
+                break;
+            }
+        }
+    }
+    if (!selected)
+        return js::THREAD_TYPE_NONE;
+
+    for (const Kind& kind : kinds) {
+        if (&kind != selected && canStart(kind))
+            passedOverCounts_[kind.counterSlot]++;
+    }
+    passedOverCounts_[selected->counterSlot] = 0;
+    dispatchedCounts_[selected->counterSlot]++;
+
+    *tier = selected->wasmTier;
+    return selected->type;
+}
+
 void
 HelperThread::threadLoop()
 {
@@ -2209,7 +2362,7 @@ HelperThread::threadLoop()
                 return;
 
             // Select the task type to run.  Task priority is determined
-            // exclusively here.
+            // exclusively by selectTask().
             //
             // The selectors may depend on the HelperThreadState not changing
             // between task selection and task execution, in particular, on new
@@ -2217,31 +2370,7 @@ HelperThread::threadLoop()
             // lists).  Unlocking the HelperThreadState between task selection
             // and execution is not well-defined.
 
-            if (HelperThreadState().canStartGCParallelTask(lock)) {
-                task = js::THREAD_TYPE_GCPARALLEL;
-            } else if (HelperThreadState().canStartGCHelperTask(lock)) {
-                task = js::THREAD_TYPE_GCHELPER;
-            } else if (HelperThreadState().canStartIonCompile(lock)) {
-                task = js::THREAD_TYPE_ION;
-            } else if (HelperThreadState().canStartWasmCompile(lock, wasm::CompileMode::Tier1)) {
-                task = js::THREAD_TYPE_WASM;
-                tier = wasm::CompileMode::Tier1;
-            } else if (HelperThreadState().canStartPromiseHelperTask(lock)) {
-                task = js::THREAD_TYPE_PROMISE_TASK;
-            } else if (HelperThreadState().canStartParseTask(lock)) {
-                task = js::THREAD_TYPE_PARSE;
-            } else if (HelperThreadState().canStartCompressionTask(lock)) {
-                task = js::THREAD_TYPE_COMPRESS;
-            } else if (HelperThreadState().canStartIonFreeTask(lock)) {
-                task = js::THREAD_TYPE_ION_FREE;
-            } else if (HelperThreadState().canStartWasmCompile(lock, wasm::CompileMode::Tier2)) {
-                task = js::THREAD_TYPE_WASM;
-                tier = wasm::CompileMode::Tier2;
-            } else if (HelperThreadState().canStartWasmTier2Generator(lock)) {
-                task = js::THREAD_TYPE_WASM_TIER2;
-            } else {
-                task = js::THREAD_TYPE_NONE;
-            }
+            task = HelperThreadState().selectTask(&tier, lock);
 
             if (task != js::THREAD_TYPE_NONE)
                 break;
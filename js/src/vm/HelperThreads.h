@@ -51,7 +51,8 @@ enum class ParseTaskKind
     Script,
     Module,
     ScriptDecode,
-    MultiScriptsDecode
+    MultiScriptsDecode,
+    JSONParse
 };
 
 namespace wasm {
@@ -100,6 +101,24 @@ class GlobalHelperThreadState
     using HelperThreadVector = Vector<HelperThread, 0, SystemAllocPolicy>;
     UniquePtr<HelperThreadVector> threads;
 
+  private:
+    // Scheduler state, protected by the helper thread lock. dispatchedCounts_
+    // counts tasks dispatched per kind for telemetry; passedOverCounts_ tracks
+    // how often a runnable kind has been skipped for higher-priority work
+    // since it last ran, which drives the starvation-avoidance rule in
+    // selectTask().
+    uint64_t dispatchedCounts_[js::THREAD_TYPE_MAX];
+    uint32_t passedOverCounts_[js::THREAD_TYPE_MAX];
+
+  public:
+    // Select the next task kind for a helper thread to run, in descending
+    // base priority but bounding how long any runnable kind can be starved.
+    js::ThreadType selectTask(wasm::CompileMode* tier, const AutoLockHelperThreadState& lock);
+
+    uint64_t dispatchedCount(js::ThreadType which, const AutoLockHelperThreadState& lock) const {
+        return dispatchedCounts_[which];
+    }
+
   private:
     // The lists below are all protected by |lock|.
 
@@ -302,6 +321,7 @@ class GlobalHelperThreadState
     JSScript* finishScriptDecodeTask(JSContext* cx, void* token);
     bool finishMultiScriptsDecodeTask(JSContext* cx, void* token, MutableHandle<ScriptVector> scripts);
     JSObject* finishModuleParseTask(JSContext* cx, void* token);
+    bool finishJSONParseTask(JSContext* cx, void* token, JS::MutableHandleValue result);
 
     bool hasActiveThreads(const AutoLockHelperThreadState&);
     void waitForAllThreadsLocked(AutoLockHelperThreadState&);
@@ -576,6 +596,15 @@ StartOffThreadDecodeMultiScripts(JSContext* cx, const ReadOnlyCompileOptions& op
                                  JS::TranscodeSources& sources,
                                  JS::OffThreadCompileCallback callback, void* callbackData);
 
+/*
+ * Start an off-thread JSON.parse of the given text. The object graph is built
+ * on a helper thread in a mergeable zone; the characters must stay alive
+ * until the parse finishes.
+ */
+bool
+StartOffThreadParseJSON(JSContext* cx, const char16_t* chars, size_t length,
+                        JS::OffThreadCompileCallback callback, void* callbackData);
+
 /*
  * Called at the end of GC to enqueue any Parse tasks that were waiting on an
  * atoms-zone GC to finish.
@@ -654,6 +683,10 @@ struct ParseTask
     // Holds the ScriptSourceObjects generated for the script compilation.
     GCVector<ScriptSourceObject*, 1> sourceObjects;
 
+    // Holds the result of a JSONParse task until the merge into the target
+    // compartment; undefined for all other kinds.
+    JS::Value jsonValue;
+
     // Any errors or warnings produced during compilation. These are reported
     // when finishing the script.
     Vector<CompileError*, 0, SystemAllocPolicy> errors;
@@ -716,6 +749,14 @@ struct MultiScriptsDecodeTask : public ParseTask
     void parse(JSContext* cx) override;
 };
 
+struct JSONParseTask : public ParseTask
+{
+    JSONParseTask(JSContext* cx, JSObject* parseGlobal,
+                  const char16_t* chars, size_t length,
+                  JS::OffThreadCompileCallback callback, void* callbackData);
+    void parse(JSContext* cx) override;
+};
+
 // Return whether, if a new parse task was started, it would need to wait for
 // an in-progress GC to complete before starting.
 extern bool
@@ -32,6 +32,7 @@
 #include "vm/TraceLogging.h"
 #include "vtune/VTuneWrapper.h"
 #include "wasm/WasmBuiltins.h"
+#include "wasm/WasmCompile.h"
 #include "wasm/WasmInstance.h"
 
 using JS::detail::InitState;
@@ -104,6 +105,7 @@ JS::detail::InitWithFailureDiagnostic(bool isDebugBuild)
     RETURN_IF_FAIL(js::Mutex::Init());
 
     RETURN_IF_FAIL(js::wasm::InitInstanceStaticData());
+    RETURN_IF_FAIL(js::wasm::InitModuleCache());
 
     js::gc::InitMemorySubsystem(); // Ensure gc::SystemPageSize() works.
 
@@ -170,6 +172,7 @@ JS_ShutDown(void)
 
     js::MemoryProtectionExceptionHandler::uninstall();
 
+    js::wasm::ShutDownModuleCache();
     js::wasm::ShutDownInstanceStaticData();
 
     js::Mutex::ShutDown();
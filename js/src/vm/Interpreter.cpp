@@ -213,6 +213,31 @@ GetPropertyOperation(JSContext* cx, InterpreterFrame* fp, HandleScript script, j
         return true;
     }
 
+    // Monomorphic fast path: cache the receiver shape and slot seen at this
+    // pc, so repeated own-data-property accesses skip the generic lookup.
+    if (lval.isObject() && lval.toObject().isNative()) {
+        NativeObject* nobj = &lval.toObject().as<NativeObject>();
+        InterpreterGetPropCache& cache = cx->caches().interpreterGetPropCache;
+
+        uint32_t slot;
+        if (cache.lookup(pc, nobj->lastProperty(), &slot)) {
+            vp.set(nobj->getSlot(slot));
+            return true;
+        }
+
+        // Dictionary shapes do not change identity on property removal, so
+        // only cache objects still on the shape tree.
+        if (!nobj->inDictionaryMode()) {
+            if (Shape* shape = nobj->lookupPure(name)) {
+                if (shape->hasSlot() && shape->hasDefaultGetter()) {
+                    cache.fill(pc, nobj->lastProperty(), shape->slot());
+                    vp.set(nobj->getSlot(shape->slot()));
+                    return true;
+                }
+            }
+        }
+    }
+
     // Copy lval, because it might alias vp.
     RootedValue v(cx, lval);
     return GetProperty(cx, v, name, vp);
@@ -6,6 +6,7 @@
 
 #include "vm/JSONParser.h"
 
+#include "mozilla/MathAlgorithms.h"
 #include "mozilla/Range.h"
 #include "mozilla/RangedPtr.h"
 #include "mozilla/Sprintf.h"
@@ -23,8 +24,255 @@
 
 using namespace js;
 
+using mozilla::CountTrailingZeroes32;
 using mozilla::RangedPtr;
 
+/*
+ * Vectorized scanning of JSON text.
+ *
+ * The parser spends most of its time in three character-at-a-time loops:
+ * finding the closing quote of an escape-free string, skipping whitespace
+ * runs, and validating digit runs.  Each has a bulk variant below which
+ * examines a vector register's worth of characters per iteration.  SSE2 is
+ * part of the x86-64 baseline ABI and NEON is guaranteed wherever the
+ * compiler defines __ARM_NEON, so no runtime dispatch is needed; other
+ * targets fall back to the scalar loops.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define JSON_PARSER_SIMD_SSE2 1
+# include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+# define JSON_PARSER_SIMD_NEON 1
+# include <arm_neon.h>
+#endif
+
+#ifdef JSON_PARSER_SIMD_SSE2
+
+/*
+ * Each *Mask function tests 16 bytes' worth of characters and returns a
+ * _mm_movemask_epi8 bitmask with (sizeof(CharT)) bits set per matching
+ * character, so the index of the first match within the chunk is always
+ * CountTrailingZeroes32(mask) / sizeof(CharT).
+ */
+
+static MOZ_ALWAYS_INLINE uint32_t
+StringSpecialMask(const Latin1Char* p)
+{
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i quote = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+    __m128i slash = _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'));
+    __m128i ctrl = _mm_cmpeq_epi8(v, _mm_min_epu8(v, _mm_set1_epi8(0x1F)));
+    return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(quote, slash), ctrl));
+}
+
+static MOZ_ALWAYS_INLINE uint32_t
+StringSpecialMask(const char16_t* p)
+{
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i quote = _mm_cmpeq_epi16(v, _mm_set1_epi16('"'));
+    __m128i slash = _mm_cmpeq_epi16(v, _mm_set1_epi16('\\'));
+    // SSE2 has no unsigned 16-bit compare; bias both sides by 0x8000 so a
+    // signed compare gives the unsigned answer (c < 0x20).
+    __m128i biased = _mm_xor_si128(v, _mm_set1_epi16(int16_t(0x8000)));
+    __m128i ctrl = _mm_cmplt_epi16(biased, _mm_set1_epi16(int16_t(0x8020)));
+    return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(quote, slash), ctrl));
+}
+
+static MOZ_ALWAYS_INLINE uint32_t
+NonWhitespaceMask(const Latin1Char* p)
+{
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                              _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+    ws = _mm_or_si128(ws, _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+    ws = _mm_or_si128(ws, _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+    return ~_mm_movemask_epi8(ws) & 0xFFFF;
+}
+
+static MOZ_ALWAYS_INLINE uint32_t
+NonWhitespaceMask(const char16_t* p)
+{
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i ws = _mm_or_si128(_mm_cmpeq_epi16(v, _mm_set1_epi16(' ')),
+                              _mm_cmpeq_epi16(v, _mm_set1_epi16('\t')));
+    ws = _mm_or_si128(ws, _mm_cmpeq_epi16(v, _mm_set1_epi16('\n')));
+    ws = _mm_or_si128(ws, _mm_cmpeq_epi16(v, _mm_set1_epi16('\r')));
+    return ~_mm_movemask_epi8(ws) & 0xFFFF;
+}
+
+static MOZ_ALWAYS_INLINE uint32_t
+NonDigitMask(const Latin1Char* p)
+{
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i t = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    __m128i digit = _mm_cmpeq_epi8(t, _mm_min_epu8(t, _mm_set1_epi8(9)));
+    return ~_mm_movemask_epi8(digit) & 0xFFFF;
+}
+
+static MOZ_ALWAYS_INLINE uint32_t
+NonDigitMask(const char16_t* p)
+{
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i biased = _mm_xor_si128(v, _mm_set1_epi16(int16_t(0x8000)));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi16(biased, _mm_set1_epi16(int16_t(0x802F))),
+                                  _mm_cmplt_epi16(biased, _mm_set1_epi16(int16_t(0x803A))));
+    return ~_mm_movemask_epi8(digit) & 0xFFFF;
+}
+
+#endif /* JSON_PARSER_SIMD_SSE2 */
+
+#ifdef JSON_PARSER_SIMD_NEON
+
+/*
+ * NEON lacks a cheap movemask, so these helpers only answer whether a chunk
+ * contains a match at all; the scalar loop then pinpoints it.
+ */
+
+static MOZ_ALWAYS_INLINE bool
+AnyLaneSet(uint8x16_t m)
+{
+    uint8x8_t narrowed = vorr_u8(vget_low_u8(m), vget_high_u8(m));
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) != 0;
+}
+
+static MOZ_ALWAYS_INLINE bool
+AnyStringSpecial(const Latin1Char* p)
+{
+    uint8x16_t v = vld1q_u8(p);
+    uint8x16_t m = vorrq_u8(vceqq_u8(v, vdupq_n_u8('"')),
+                            vceqq_u8(v, vdupq_n_u8('\\')));
+    m = vorrq_u8(m, vcltq_u8(v, vdupq_n_u8(0x20)));
+    return AnyLaneSet(m);
+}
+
+static MOZ_ALWAYS_INLINE bool
+AnyStringSpecial(const char16_t* p)
+{
+    uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t*>(p));
+    uint16x8_t m = vorrq_u16(vceqq_u16(v, vdupq_n_u16('"')),
+                             vceqq_u16(v, vdupq_n_u16('\\')));
+    m = vorrq_u16(m, vcltq_u16(v, vdupq_n_u16(0x20)));
+    return AnyLaneSet(vreinterpretq_u8_u16(m));
+}
+
+static MOZ_ALWAYS_INLINE bool
+AnyNonWhitespace(const Latin1Char* p)
+{
+    uint8x16_t v = vld1q_u8(p);
+    uint8x16_t ws = vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')),
+                             vceqq_u8(v, vdupq_n_u8('\t')));
+    ws = vorrq_u8(ws, vceqq_u8(v, vdupq_n_u8('\n')));
+    ws = vorrq_u8(ws, vceqq_u8(v, vdupq_n_u8('\r')));
+    return AnyLaneSet(vmvnq_u8(ws));
+}
+
+static MOZ_ALWAYS_INLINE bool
+AnyNonWhitespace(const char16_t* p)
+{
+    uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t*>(p));
+    uint16x8_t ws = vorrq_u16(vceqq_u16(v, vdupq_n_u16(' ')),
+                              vceqq_u16(v, vdupq_n_u16('\t')));
+    ws = vorrq_u16(ws, vceqq_u16(v, vdupq_n_u16('\n')));
+    ws = vorrq_u16(ws, vceqq_u16(v, vdupq_n_u16('\r')));
+    return AnyLaneSet(vreinterpretq_u8_u16(vmvnq_u16(ws)));
+}
+
+static MOZ_ALWAYS_INLINE bool
+AnyNonDigit(const Latin1Char* p)
+{
+    uint8x16_t v = vld1q_u8(p);
+    uint8x16_t digit = vandq_u8(vcgeq_u8(v, vdupq_n_u8('0')),
+                                vcleq_u8(v, vdupq_n_u8('9')));
+    return AnyLaneSet(vmvnq_u8(digit));
+}
+
+static MOZ_ALWAYS_INLINE bool
+AnyNonDigit(const char16_t* p)
+{
+    uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t*>(p));
+    uint16x8_t digit = vandq_u16(vcgeq_u16(v, vdupq_n_u16('0')),
+                                 vcleq_u16(v, vdupq_n_u16('9')));
+    return AnyLaneSet(vreinterpretq_u8_u16(vmvnq_u16(digit)));
+}
+
+#endif /* JSON_PARSER_SIMD_NEON */
+
+/*
+ * Return a pointer to the first character in [p, end) which terminates a run
+ * of plain string characters — a closing quote, a backslash, or a control
+ * character — or end if there is none.
+ */
+template <typename CharT>
+static MOZ_ALWAYS_INLINE const CharT*
+FindStringSpecialChar(const CharT* p, const CharT* end)
+{
+    static const size_t CharsPerChunk = 16 / sizeof(CharT);
+#if defined(JSON_PARSER_SIMD_SSE2)
+    while (size_t(end - p) >= CharsPerChunk) {
+        uint32_t mask = StringSpecialMask(p);
+        if (mask)
+            return p + CountTrailingZeroes32(mask) / sizeof(CharT);
+        p += CharsPerChunk;
+    }
+#elif defined(JSON_PARSER_SIMD_NEON)
+    while (size_t(end - p) >= CharsPerChunk && !AnyStringSpecial(p))
+        p += CharsPerChunk;
+#endif
+    for (; p < end; p++) {
+        if (*p == '"' || *p == '\\' || *p <= CharT(0x001F))
+            break;
+    }
+    return p;
+}
+
+/* Return a pointer to the first non-whitespace character in [p, end). */
+template <typename CharT>
+static MOZ_ALWAYS_INLINE const CharT*
+SkipJSONWhitespace(const CharT* p, const CharT* end)
+{
+    static const size_t CharsPerChunk = 16 / sizeof(CharT);
+#if defined(JSON_PARSER_SIMD_SSE2)
+    while (size_t(end - p) >= CharsPerChunk) {
+        uint32_t mask = NonWhitespaceMask(p);
+        if (mask)
+            return p + CountTrailingZeroes32(mask) / sizeof(CharT);
+        p += CharsPerChunk;
+    }
+#elif defined(JSON_PARSER_SIMD_NEON)
+    while (size_t(end - p) >= CharsPerChunk && !AnyNonWhitespace(p))
+        p += CharsPerChunk;
+#endif
+    for (; p < end; p++) {
+        if (!(*p == '\t' || *p == '\r' || *p == '\n' || *p == ' '))
+            break;
+    }
+    return p;
+}
+
+/* Return a pointer to the first non-decimal-digit character in [p, end). */
+template <typename CharT>
+static MOZ_ALWAYS_INLINE const CharT*
+SkipDecimalDigits(const CharT* p, const CharT* end)
+{
+    static const size_t CharsPerChunk = 16 / sizeof(CharT);
+#if defined(JSON_PARSER_SIMD_SSE2)
+    while (size_t(end - p) >= CharsPerChunk) {
+        uint32_t mask = NonDigitMask(p);
+        if (mask)
+            return p + CountTrailingZeroes32(mask) / sizeof(CharT);
+        p += CharsPerChunk;
+    }
+#elif defined(JSON_PARSER_SIMD_NEON)
+    while (size_t(end - p) >= CharsPerChunk && !AnyNonDigit(p))
+        p += CharsPerChunk;
+#endif
+    for (; p < end; p++) {
+        if (!JS7_ISDEC(*p))
+            break;
+    }
+    return p;
+}
+
 JSONParserBase::~JSONParserBase()
 {
     for (size_t i = 0; i < stack.length(); i++) {
@@ -129,7 +377,8 @@ JSONParser<CharT>::readString()
      * string directly from the source text.
      */
     CharPtr start = current;
-    for (; current < end; current++) {
+    current += FindStringSpecialChar(current.get(), end.get()) - current.get();
+    if (current < end) {
         if (*current == '"') {
             size_t length = current - start;
             current++;
@@ -141,10 +390,8 @@ JSONParser<CharT>::readString()
             return stringToken(str);
         }
 
-        if (*current == '\\')
-            break;
-
-        if (*current <= 0x001F) {
+        if (*current != '\\') {
+            MOZ_ASSERT(*current <= 0x001F);
             error("bad control character in string literal");
             return token(Error);
         }
@@ -231,10 +478,7 @@ JSONParser<CharT>::readString()
             return token(OOM);
 
         start = current;
-        for (; current < end; current++) {
-            if (*current == '"' || *current == '\\' || *current <= 0x001F)
-                break;
-        }
+        current += FindStringSpecialChar(current.get(), end.get()) - current.get();
     } while (current < end);
 
     error("unterminated string");
@@ -268,12 +512,8 @@ JSONParser<CharT>::readNumber()
         error("unexpected non-digit");
         return token(Error);
     }
-    if (*current++ != '0') {
-        for (; current < end; current++) {
-            if (!JS7_ISDEC(*current))
-                break;
-        }
-    }
+    if (*current++ != '0')
+        current += SkipDecimalDigits(current.get(), end.get()) - current.get();
 
     /* Fast path: no fractional or exponent part. */
     if (current == end || (*current != '.' && *current != 'e' && *current != 'E')) {
@@ -305,10 +545,8 @@ JSONParser<CharT>::readNumber()
             error("unterminated fractional number");
             return token(Error);
         }
-        while (++current < end) {
-            if (!JS7_ISDEC(*current))
-                break;
-        }
+        current++;
+        current += SkipDecimalDigits(current.get(), end.get()) - current.get();
     }
 
     /* ([eE][\+\-]?[0-9]+)? */
@@ -327,10 +565,8 @@ JSONParser<CharT>::readNumber()
             error("exponent part is missing a number");
             return token(Error);
         }
-        while (++current < end) {
-            if (!JS7_ISDEC(*current))
-                break;
-        }
+        current++;
+        current += SkipDecimalDigits(current.get(), end.get()) - current.get();
     }
 
     double d;
@@ -351,8 +587,7 @@ template <typename CharT>
 JSONParserBase::Token
 JSONParser<CharT>::advance()
 {
-    while (current < end && IsJSONWhitespace(*current))
-        current++;
+    current += SkipJSONWhitespace(current.get(), end.get()) - current.get();
     if (current >= end) {
         error("unexpected end of data");
         return token(Error);
@@ -435,8 +670,7 @@ JSONParser<CharT>::advanceAfterObjectOpen()
 {
     MOZ_ASSERT(current[-1] == '{');
 
-    while (current < end && IsJSONWhitespace(*current))
-        current++;
+    current += SkipJSONWhitespace(current.get(), end.get()) - current.get();
     if (current >= end) {
         error("end of data while reading object contents");
         return token(Error);
@@ -488,8 +722,7 @@ JSONParser<CharT>::advanceAfterArrayElement()
 {
     AssertPastValue(current);
 
-    while (current < end && IsJSONWhitespace(*current))
-        current++;
+    current += SkipJSONWhitespace(current.get(), end.get()) - current.get();
     if (current >= end) {
         error("end of data when ',' or ']' was expected");
         return token(Error);
@@ -515,8 +748,7 @@ JSONParser<CharT>::advancePropertyName()
 {
     MOZ_ASSERT(current[-1] == ',');
 
-    while (current < end && IsJSONWhitespace(*current))
-        current++;
+    current += SkipJSONWhitespace(current.get(), end.get()) - current.get();
     if (current >= end) {
         error("end of data when property name was expected");
         return token(Error);
@@ -535,8 +767,7 @@ JSONParser<CharT>::advancePropertyColon()
 {
     MOZ_ASSERT(current[-1] == '"');
 
-    while (current < end && IsJSONWhitespace(*current))
-        current++;
+    current += SkipJSONWhitespace(current.get(), end.get()) - current.get();
     if (current >= end) {
         error("end of data after property name when ':' was expected");
         return token(Error);
@@ -557,8 +788,7 @@ JSONParser<CharT>::advanceAfterProperty()
 {
     AssertPastValue(current);
 
-    while (current < end && IsJSONWhitespace(*current))
-        current++;
+    current += SkipJSONWhitespace(current.get(), end.get()) - current.get();
     if (current >= end) {
         error("end of data after property value in object");
         return token(Error);
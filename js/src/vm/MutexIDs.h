@@ -45,6 +45,7 @@
   _(OffThreadPromiseState,       500) \
   _(WasmModuleTieringLock,       500) \
   _(WasmCompileTaskState,        500) \
+  _(WasmModuleCache,             500) \
                                       \
   _(TraceLoggerGraphState,       600) \
   _(VTuneLock,                   600)
@@ -2420,6 +2420,32 @@ bool
 js::NativeGetProperty(JSContext* cx, HandleNativeObject obj, HandleValue receiver, HandleId id,
                       MutableHandleValue vp)
 {
+    // Megamorphic sites that overflow their CacheIR stubs land here on every
+    // access; serve repeated own-data-slot reads from the runtime-wide
+    // (shape, id) cache. Mirrors the interpreter getprop cache's safety
+    // rules: non-dictionary shapes and plain data properties only, and the
+    // receiver must be the object itself so no proto-walk or getter is
+    // bypassed.
+    if (receiver.isObject() && &receiver.toObject() == obj.get()) {
+        MegamorphicSlotCache& cache = cx->caches().megamorphicSlotCache;
+
+        uint32_t slot;
+        if (cache.lookup(obj->lastProperty(), id, &slot)) {
+            vp.set(obj->getSlot(slot));
+            return true;
+        }
+
+        if (!obj->inDictionaryMode()) {
+            if (Shape* shape = obj->lookupPure(id)) {
+                if (shape->hasSlot() && shape->hasDefaultGetter()) {
+                    cache.fill(obj->lastProperty(), id, shape->slot());
+                    vp.set(obj->getSlot(shape->slot()));
+                    return true;
+                }
+            }
+        }
+    }
+
     return NativeGetPropertyInline<CanGC>(cx, obj, receiver, id, NotNameLookup, vp);
 }
 
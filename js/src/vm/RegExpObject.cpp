@@ -18,6 +18,7 @@
 #include "builtin/RegExp.h"
 #include "frontend/TokenStream.h"
 #ifdef DEBUG
+#include "irregexp/RegExpAST.h"
 #include "irregexp/RegExpBytecode.h"
 #endif
 #include "irregexp/RegExpParser.h"
@@ -936,7 +937,7 @@ js::StringHasRegExpMetaChars(JSLinearString* str)
 /* RegExpShared */
 
 RegExpShared::RegExpShared(JSAtom* source, RegExpFlag flags)
-  : source(source), flags(flags), canStringMatch(false), parenCount(0)
+  : source(source), prefilter(nullptr), flags(flags), canStringMatch(false), parenCount(0)
 {}
 
 void
@@ -947,6 +948,7 @@ RegExpShared::traceChildren(JSTracer* trc)
         discardJitCode();
 
     TraceNullableEdge(trc, &source, "RegExpShared source");
+    TraceNullableEdge(trc, &prefilter, "RegExpShared prefilter");
     for (auto& comp : compilationArray)
         TraceNullableEdge(trc, &comp.jitCode, "RegExpShared code");
 }
@@ -1003,6 +1005,30 @@ RegExpShared::compile(JSContext* cx, MutableHandleRegExpShared re, HandleAtom pa
 
     re->parenCount = data.capture_count;
 
+    // Extract a mandatory literal prefix for the execute() prefilter. Only
+    // case-sensitive, non-unicode patterns whose top-level tree begins with a
+    // plain atom qualify; anchors, classes, disjunctions and captures at the
+    // front all disqualify the pattern, conservatively.
+    if (!re->prefilter && !re->ignoreCase() && !re->unicode() && !re->canStringMatch) {
+        irregexp::RegExpAtom* atom = nullptr;
+        if (data.tree->IsAtom())
+            atom = data.tree->AsAtom();
+        else if (data.tree->IsAlternative() && data.tree->AsAlternative()->nodes().length() > 0 &&
+                 data.tree->AsAlternative()->nodes()[0]->IsAtom())
+        {
+            atom = data.tree->AsAlternative()->nodes()[0]->AsAtom();
+        }
+
+        if (atom && atom->data().length() > 0) {
+            static const size_t MaxPrefilterLength = 32;
+            size_t prefixLength = Min(atom->data().length(), MaxPrefilterLength);
+            JSAtom* prefix = AtomizeChars(cx, atom->data().begin(), prefixLength);
+            if (!prefix)
+                return false;
+            re->prefilter = prefix;
+        }
+    }
+
     JitCodeTables tables;
     irregexp::RegExpCode code = irregexp::CompilePattern(cx, re, &data, input,
                                                          false /* global() */,
@@ -1112,6 +1138,21 @@ RegExpShared::execute(JSContext* cx, MutableHandleRegExpShared re, HandleLinearS
         return RegExpRunStatus_Success;
     }
 
+    /*
+     * No match can begin before the first occurrence of the mandatory literal
+     * prefix, so skip ahead with the vectorized substring search before
+     * entering the engine. Sticky patterns must match at |start| exactly and
+     * get no benefit.
+     */
+    if (re->prefilter && !re->sticky()) {
+        if (start + re->prefilter->length() > length)
+            return RegExpRunStatus_Success_NotFound;
+        int res = StringFindPattern(input, re->prefilter, start);
+        if (res == -1)
+            return RegExpRunStatus_Success_NotFound;
+        start = size_t(res);
+    }
+
     do {
         jit::JitCode* code = re->compilation(mode, input->hasLatin1Chars()).jitCode;
         if (!code)
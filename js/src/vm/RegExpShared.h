@@ -118,6 +118,14 @@ class RegExpShared : public gc::TenuredCell
     /* Source to the RegExp, for lazy compilation. */
     GCPtr<JSAtom*>     source;
 
+    /*
+     * If the pattern can only match beginning with a fixed literal (e.g. the
+     * "foo" of /foo\d+/), that literal, atomized at compile time. Used by
+     * execute() to skip ahead to the first candidate position with a fast
+     * substring search before entering the engine proper.
+     */
+    GCPtr<JSAtom*>     prefilter;
+
     RegExpFlag         flags;
     bool               canStringMatch;
     size_t             parenCount;
@@ -185,6 +185,8 @@ JSRuntime::JSRuntime(JSRuntime* parentRuntime)
     /* Initialize infallibly first, so we can goto bad and JS_DestroyRuntime. */
 
     PodZero(&asmJSCacheOps);
+    PodZero(&scriptBytecodeCacheOps);
+    scriptBytecodeCacheData = nullptr;
     lcovOutput().init();
 }
 
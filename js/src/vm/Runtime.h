@@ -548,6 +548,10 @@ struct JSRuntime : public js::MallocProvider<JSRuntime>
     /* AsmJSCache callbacks are runtime-wide. */
     js::UnprotectedData<JS::AsmJSCacheOps> asmJSCacheOps;
 
+    /* Script bytecode cache hooks are runtime-wide. */
+    js::UnprotectedData<JS::ScriptBytecodeCacheOps> scriptBytecodeCacheOps;
+    js::UnprotectedData<void*> scriptBytecodeCacheData;
+
   private:
     js::UnprotectedData<const JSPrincipals*> trustedPrincipals_;
   public:
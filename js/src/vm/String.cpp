@@ -600,6 +600,13 @@ EnsureLinear(JSContext* cx, typename MaybeRooted<JSString*, allowGC>::HandleType
     return linear;
 }
 
+/*
+ * Ropes at least this long are queued for idle flattening: the flatten cost
+ * scales with length and below this the first-use pause is negligible.
+ */
+static const size_t PendingFlattenMinLength = 256 * 1024;
+static const size_t MaxPendingRopeFlattens = 16;
+
 template <AllowGC allowGC>
 JSString*
 js::ConcatStrings(JSContext* cx,
@@ -665,7 +672,21 @@ js::ConcatStrings(JSContext* cx,
         return str;
     }
 
-    return JSRope::new_<allowGC>(cx, left, right, wholeLength);
+    JSRope* rope = JSRope::new_<allowGC>(cx, left, right, wholeLength);
+
+    /*
+     * Note large ropes so an embedder-driven idle pass can flatten them
+     * before first use; see JS::FlattenPendingRopes. The list holds strong
+     * roots, so it is bounded and strictly opportunistic.
+     */
+    if (rope && allowGC && !cx->helperThread() &&
+        wholeLength >= PendingFlattenMinLength &&
+        cx->pendingRopeFlattens().length() < MaxPendingRopeFlattens)
+    {
+        mozilla::Unused << cx->pendingRopeFlattens().append(rope);
+    }
+
+    return rope;
 }
 
 template JSString*
@@ -18,12 +18,17 @@
 
 #include "wasm/WasmCompile.h"
 
+#include <algorithm>
+
+#include "mozilla/HashFunctions.h"
 #include "mozilla/Maybe.h"
 #include "mozilla/Unused.h"
 
 #include "jsprf.h"
 
 #include "jit/ProcessExecutableMemory.h"
+#include "threading/ExclusiveData.h"
+#include "vm/MutexIDs.h"
 #include "wasm/WasmBaselineCompile.h"
 #include "wasm/WasmBinaryIterator.h"
 #include "wasm/WasmGenerator.h"
@@ -34,6 +39,112 @@ using namespace js;
 using namespace js::jit;
 using namespace js::wasm;
 
+using mozilla::HashBytes;
+using mozilla::HashGeneric;
+
+// A small process-wide cache of recently compiled modules, keyed by a hash of
+// the bytecode and of the compile arguments that affect generated code.
+// Compiled modules are immutable and shareable between threads and contexts,
+// so a page reloading the same .wasm (the common kiosk/dashboard pattern)
+// reuses the machine code instead of recompiling. The cache is deliberately
+// tiny: modules keep their bytecode and code segments alive, so a handful of
+// entries already covers the reload case without noticeably raising the
+// process footprint.
+
+struct ModuleCacheKey
+{
+    uint32_t bytecodeHash;
+    // Module metadata carries the compiling page's URL (it surfaces in wasm
+    // stack traces and devtools), so the cache must not share modules across
+    // documents with different scripted callers - least of all cross-origin
+    // ones sharing a content process.
+    uint32_t callerFilenameHash;
+    size_t bytecodeLength;
+    bool baselineEnabled;
+    bool ionEnabled;
+
+    typedef ModuleCacheKey Lookup;
+
+    static HashNumber hash(const Lookup& l) {
+        return HashGeneric(l.bytecodeHash, l.callerFilenameHash, l.bytecodeLength,
+                           l.baselineEnabled, l.ionEnabled);
+    }
+    static bool match(const ModuleCacheKey& k, const Lookup& l) {
+        return k.bytecodeHash == l.bytecodeHash &&
+               k.callerFilenameHash == l.callerFilenameHash &&
+               k.bytecodeLength == l.bytecodeLength &&
+               k.baselineEnabled == l.baselineEnabled &&
+               k.ionEnabled == l.ionEnabled;
+    }
+};
+
+typedef HashMap<ModuleCacheKey, SharedModule, ModuleCacheKey, SystemAllocPolicy> ModuleCacheMap;
+
+static const size_t MaxCachedModules = 4;
+
+static ExclusiveData<ModuleCacheMap>* moduleCache = nullptr;
+
+bool
+js::wasm::InitModuleCache()
+{
+    MOZ_ASSERT(!moduleCache);
+    moduleCache = js_new<ExclusiveData<ModuleCacheMap>>(mutexid::WasmModuleCache);
+    return moduleCache != nullptr;
+}
+
+void
+js::wasm::ShutDownModuleCache()
+{
+    MOZ_ASSERT(moduleCache);
+    js_delete(moduleCache);
+    moduleCache = nullptr;
+}
+
+static ModuleCacheKey
+MakeModuleCacheKey(const ShareableBytes& bytecode, const CompileArgs& args)
+{
+    ModuleCacheKey key;
+    key.bytecodeHash = HashBytes(bytecode.begin(), bytecode.length());
+    key.callerFilenameHash = args.scriptedCaller.filename
+                             ? mozilla::HashString(args.scriptedCaller.filename.get())
+                             : 0;
+    key.bytecodeLength = bytecode.length();
+    key.baselineEnabled = args.baselineEnabled;
+    key.ionEnabled = args.ionEnabled;
+    return key;
+}
+
+static SharedModule
+LookupCachedModule(const ModuleCacheKey& key, const ShareableBytes& bytecode)
+{
+    auto cache = moduleCache->lock();
+    if (!cache->initialized())
+        return nullptr;
+    ModuleCacheMap::Ptr p = cache->lookup(key);
+    if (!p)
+        return nullptr;
+
+    // The hash is only probabilistic; the full bytecode must match.
+    SharedModule module = p->value();
+    if (module->bytecode().length() != bytecode.length() ||
+        memcmp(module->bytecode().begin(), bytecode.begin(), bytecode.length()) != 0)
+    {
+        return nullptr;
+    }
+    return module;
+}
+
+static void
+CacheModule(const ModuleCacheKey& key, Module* module)
+{
+    auto cache = moduleCache->lock();
+    if (!cache->initialized() && !cache->init())
+        return;
+    if (cache->count() >= MaxCachedModules)
+        cache->clear();
+    mozilla::Unused << cache->putNew(key, module);
+}
+
 static bool
 DecodeFunctionBody(Decoder& d, ModuleGenerator& mg, uint32_t funcIndex)
 {
@@ -86,6 +197,96 @@ DecodeCodeSection(Decoder& d, ModuleGenerator& mg, ModuleEnvironment* env)
     return mg.finishFuncDefs();
 }
 
+struct Tier2FuncDef
+{
+    uint32_t funcIndex;
+    uint32_t offsetInModule;
+    const uint8_t* begin;
+    uint32_t bodySize;
+    bool exported;
+};
+
+// For tier-2 compilation the whole bytecode is resident, so rather than
+// feeding function bodies to the generator in module order we can choose the
+// order: exported functions (and hence the module's entry points) first, so
+// their Ion code becomes patchable soonest, and the remainder by decreasing
+// size so a huge body does not serialize the tail of the parallel batch
+// compilation.
+static bool
+DecodeCodeSectionTier2(Decoder& d, ModuleGenerator& mg, ModuleEnvironment* env)
+{
+    uint32_t sectionStart, sectionSize;
+    if (!d.startSection(SectionId::Code, env, &sectionStart, &sectionSize, "code"))
+        return false;
+
+    if (!mg.startFuncDefs())
+        return false;
+
+    if (sectionStart == Decoder::NotStarted) {
+        if (env->numFuncDefs() != 0)
+            return d.fail("expected function bodies");
+
+        return mg.finishFuncDefs();
+    }
+
+    uint32_t numFuncDefs;
+    if (!d.readVarU32(&numFuncDefs))
+        return d.fail("expected function body count");
+
+    if (numFuncDefs != env->numFuncDefs())
+        return d.fail("function body count does not match function signature count");
+
+    Vector<bool, 0, SystemAllocPolicy> exported;
+    if (!exported.appendN(false, env->numFuncs()))
+        return false;
+    for (const Export& exp : env->exports) {
+        if (exp.kind() == DefinitionKind::Function)
+            exported[exp.funcIndex()] = true;
+    }
+    for (const ElemSegment& elems : env->elemSegments) {
+        for (uint32_t funcIndex : elems.elemFuncIndices)
+            exported[funcIndex] = true;
+    }
+
+    Vector<Tier2FuncDef, 0, SystemAllocPolicy> funcDefs;
+    if (!funcDefs.reserve(numFuncDefs))
+        return false;
+
+    for (uint32_t funcDefIndex = 0; funcDefIndex < numFuncDefs; funcDefIndex++) {
+        uint32_t bodySize;
+        if (!d.readVarU32(&bodySize))
+            return d.fail("expected number of function body bytes");
+
+        const size_t offsetInModule = d.currentOffset();
+
+        const uint8_t* bodyBegin;
+        if (!d.readBytes(bodySize, &bodyBegin))
+            return d.fail("function body length too big");
+
+        uint32_t funcIndex = env->numFuncImports() + funcDefIndex;
+        funcDefs.infallibleAppend(Tier2FuncDef { funcIndex, uint32_t(offsetInModule),
+                                                 bodyBegin, bodySize, exported[funcIndex] });
+    }
+
+    if (!d.finishSection(sectionStart, sectionSize, "code"))
+        return false;
+
+    std::stable_sort(funcDefs.begin(), funcDefs.end(),
+                     [](const Tier2FuncDef& lhs, const Tier2FuncDef& rhs) {
+                         if (lhs.exported != rhs.exported)
+                             return lhs.exported;
+                         return lhs.bodySize > rhs.bodySize;
+                     });
+
+    for (const Tier2FuncDef& def : funcDefs) {
+        if (!mg.compileFuncDef(def.funcIndex, def.offsetInModule, def.begin,
+                               def.begin + def.bodySize))
+            return false;
+    }
+
+    return mg.finishFuncDefs();
+}
+
 bool
 CompileArgs::initFromContext(JSContext* cx, ScriptedCaller&& scriptedCaller)
 {
@@ -391,6 +592,16 @@ wasm::CompileInitialTier(const ShareableBytes& bytecode, const CompileArgs& args
 {
     MOZ_RELEASE_ASSERT(wasm::HaveSignalHandlers());
 
+    // Debug-enabled modules hold per-instance state and must not be shared
+    // through the cache.
+    bool cacheable = !args.debugEnabled;
+    ModuleCacheKey cacheKey;
+    if (cacheable) {
+        cacheKey = MakeModuleCacheKey(bytecode, args);
+        if (SharedModule module = LookupCachedModule(cacheKey, bytecode))
+            return module;
+    }
+
     bool baselineEnabled = BaselineCanCompile() && args.baselineEnabled;
     bool debugEnabled = BaselineCanCompile() && args.debugEnabled;
     bool ionEnabled = args.ionEnabled || !baselineEnabled;
@@ -429,7 +640,10 @@ wasm::CompileInitialTier(const ShareableBytes& bytecode, const CompileArgs& args
     if (!DecodeModuleTail(d, &env))
         return nullptr;
 
-    return mg.finishModule(bytecode);
+    SharedModule module = mg.finishModule(bytecode);
+    if (module && cacheable)
+        CacheModule(cacheKey, const_cast<Module*>(module.get()));
+    return module;
 }
 
 bool
@@ -448,7 +662,7 @@ wasm::CompileTier2(Module& module, const CompileArgs& args, Atomic<bool>* cancel
     if (!mg.init(module.bytecode().length()))
         return false;
 
-    if (!DecodeCodeSection(d, mg, &env))
+    if (!DecodeCodeSectionTier2(d, mg, &env))
         return false;
 
     if (!DecodeModuleTail(d, &env))
@@ -60,6 +60,15 @@ struct CompileArgs : ShareableBase<CompileArgs>
 typedef RefPtr<CompileArgs> MutableCompileArgs;
 typedef RefPtr<const CompileArgs> SharedCompileArgs;
 
+// Initialize and shut down the process-wide cache of compiled modules used by
+// CompileInitialTier. Called during JS engine (de)initialization.
+
+MOZ_MUST_USE bool
+InitModuleCache();
+
+void
+ShutDownModuleCache();
+
 // Return the estimated compiled (machine) code size for the given bytecode size
 // compiled at the given tier.
 
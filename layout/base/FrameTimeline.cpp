@@ -0,0 +1,60 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "mozilla/FrameTimeline.h"
+
+#include <algorithm>
+
+namespace mozilla {
+
+namespace {
+
+struct StageRing
+{
+  Atomic<uint32_t, Relaxed> mCursor;
+  double mDurationsMs[FrameTimeline::kRingSize];
+};
+
+// Zero-initialized; unrecorded slots read as 0ms and are skipped by queries.
+static StageRing sRings[size_t(FrameStage::Count)];
+
+} // namespace
+
+/* static */ void
+FrameTimeline::Record(FrameStage aStage, TimeDuration aDuration)
+{
+  StageRing& ring = sRings[size_t(aStage)];
+  uint32_t index = ring.mCursor++ & (kRingSize - 1);
+  ring.mDurationsMs[index] = aDuration.ToMilliseconds();
+}
+
+/* static */ void
+FrameTimeline::GetPercentiles(FrameStage aStage, double* aP50, double* aP95,
+                              double* aP99)
+{
+  StageRing& ring = sRings[size_t(aStage)];
+
+  double sorted[kRingSize];
+  size_t count = 0;
+  for (size_t i = 0; i < kRingSize; i++) {
+    double ms = ring.mDurationsMs[i];
+    if (ms > 0) {
+      sorted[count++] = ms;
+    }
+  }
+
+  if (count == 0) {
+    *aP50 = *aP95 = *aP99 = 0;
+    return;
+  }
+
+  std::sort(sorted, sorted + count);
+  *aP50 = sorted[count / 2];
+  *aP95 = sorted[std::min(count - 1, count * 95 / 100)];
+  *aP99 = sorted[std::min(count - 1, count * 99 / 100)];
+}
+
+} // namespace mozilla
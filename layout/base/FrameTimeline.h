@@ -0,0 +1,68 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef mozilla_FrameTimeline_h
+#define mozilla_FrameTimeline_h
+
+#include "mozilla/Atomics.h"
+#include "mozilla/TimeStamp.h"
+
+namespace mozilla {
+
+/**
+ * Always-on, low-overhead instrumentation of where frame time goes. Each
+ * pipeline stage records its duration into a fixed per-stage ring; recording
+ * is one atomic increment and one double store, cheap enough to stay enabled
+ * in release builds. Percentile queries walk the ring on demand (diagnostics
+ * code only) rather than maintaining any state on the hot path.
+ *
+ * Stages are recorded from different threads (composite on the compositor
+ * thread), so each stage has its own independent ring.
+ */
+enum class FrameStage : uint8_t
+{
+  Tick,         // nsRefreshDriver::Tick, end to end.
+  Style,        // Style flushes under DoFlushPendingNotifications.
+  Layout,       // Layout (reflow) flushes, ditto.
+  Paint,        // nsLayoutUtils::PaintFrame: display list build + paint.
+  Composite,    // CompositorBridgeParent::CompositeToTarget.
+  Count
+};
+
+class FrameTimeline
+{
+public:
+  static const size_t kRingSize = 256;  // Must be a power of two.
+
+  static void Record(FrameStage aStage, TimeDuration aDuration);
+
+  // Fill percentiles (in milliseconds) over the last kRingSize recordings of
+  // the stage. Intended for chrome diagnostics / telemetry collection, not
+  // for per-frame use.
+  static void GetPercentiles(FrameStage aStage, double* aP50, double* aP95,
+                             double* aP99);
+
+  // RAII helper for recording a stage around a scope.
+  class MOZ_RAII AutoRecord
+  {
+  public:
+    explicit AutoRecord(FrameStage aStage)
+      : mStage(aStage)
+      , mStart(TimeStamp::Now())
+    {
+    }
+
+    ~AutoRecord() { Record(mStage, TimeStamp::Now() - mStart); }
+
+  private:
+    FrameStage mStage;
+    TimeStamp mStart;
+  };
+};
+
+} // namespace mozilla
+
+#endif // mozilla_FrameTimeline_h
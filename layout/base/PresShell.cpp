@@ -14,6 +14,7 @@
 #include "mozilla/EventDispatcher.h"
 #include "mozilla/EventStateManager.h"
 #include "mozilla/EventStates.h"
+#include "mozilla/FrameTimeline.h"
 #include "mozilla/IMEStateManager.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/dom/TabChild.h"
@@ -2067,6 +2068,10 @@ PresShell::SetIgnoreFrameDestruction(bool aIgnore)
 void
 PresShell::NotifyDestroyingFrame(nsIFrame* aFrame)
 {
+  if (aFrame->GetStateBits() & NS_FRAME_NEEDS_DISPLAY_ITEM_REBUILD) {
+    mModifiedFramesForDisplayList.RemoveElement(aFrame);
+  }
+
   // We must remove these from FrameLayerBuilder::DisplayItemData::mFrameList here,
   // otherwise the DisplayItemData destructor will use the destroyed frame when it
   // tries to remove it from the (array) value of this property.
@@ -2115,6 +2120,33 @@ PresShell::NotifyDestroyingFrame(nsIFrame* aFrame)
   }
 }
 
+static bool
+ClearModifiedFramesForSubDocument(nsIDocument* aDocument, void* aData)
+{
+  if (nsIPresShell* shell = aDocument->GetShell()) {
+    shell->ClearModifiedFramesForDisplayList();
+  }
+  return true;
+}
+
+void
+nsIPresShell::ClearModifiedFramesForDisplayList()
+{
+  for (nsIFrame* frame : mModifiedFramesForDisplayList) {
+    frame->RemoveStateBits(NS_FRAME_NEEDS_DISPLAY_ITEM_REBUILD);
+  }
+  mModifiedFramesForDisplayList.Clear();
+
+  // A paint of this document repaints its in-process subdocuments too, but
+  // their shells track their own modified frames; reset them (recursively)
+  // along with ours, or iframe shells saturate their caps and their frames
+  // keep NS_FRAME_NEEDS_DISPLAY_ITEM_REBUILD forever.
+  if (mDocument) {
+    mDocument->EnumerateSubDocuments(ClearModifiedFramesForSubDocument,
+                                     nullptr);
+  }
+}
+
 already_AddRefed<nsCaret> PresShell::GetCaret() const
 {
   RefPtr<nsCaret> caret = mCaret;
@@ -4046,6 +4078,12 @@ PresShell::DoFlushPendingNotifications(FlushType aType)
 void
 PresShell::DoFlushPendingNotifications(mozilla::ChangesToFlush aFlush)
 {
+  // Attribute flush time to the frame timeline: style-only flushes record as
+  // Style, anything reaching layout records as Layout.
+  mozilla::FrameTimeline::AutoRecord record(
+    aFlush.mFlushType >= FlushType::InterruptibleLayout ? mozilla::FrameStage::Layout
+                                           : mozilla::FrameStage::Style);
+
   // Per our API contract, hold a strong ref to ourselves until we return.
   nsCOMPtr<nsIPresShell> kungFuDeathGrip = this;
 
@@ -4097,6 +4135,26 @@ PresShell::DoFlushPendingNotifications(mozilla::ChangesToFlush aFlush)
 
   bool isSafeToFlush = IsSafeToFlush();
 
+  // Opt-in throttling of synchronous flushes triggered from scroll event
+  // handlers: service at most one per refresh tick and defer the rest, so a
+  // scroll listener forcing layout cannot defeat APZ. The deferred flush
+  // happens on the next tick via the observation below.
+  static bool sThrottleScrollFlushes =
+    Preferences::GetBool("layout.throttle_scroll_flushes", false);
+  if (isSafeToFlush && sThrottleScrollFlushes && mFiringScrollEvent) {
+    TimeStamp lastTick = mPresContext->RefreshDriver()->MostRecentRefresh();
+    if (mLastScrollHandlerFlushTick == lastTick) {
+      mScrollFlushesDeferred++;
+      mNeedStyleFlush = true;
+      if (flushType >= FlushType::InterruptibleLayout) {
+        mNeedLayoutFlush = true;
+      }
+      DoObserveStyleFlushes();
+      return;
+    }
+    mLastScrollHandlerFlushTick = lastTick;
+  }
+
   // If layout could possibly trigger scripts, then it's only safe to flush if
   // it's safe to run script.
   bool hasHadScriptObject;
@@ -9735,6 +9793,7 @@ PresShell::Observe(nsISupports* aSubject,
 #endif
 
   if (!nsCRT::strcmp(aTopic, "memory-pressure")) {
+    nsPresArena::ClearRecycledChunkPool();
     if (!AssumeAllFramesVisible() && mPresContext->IsRootContentDocument()) {
       DoUpdateApproximateFrameVisibility(/* aRemoveOnly = */ true);
     }
@@ -1622,6 +1622,39 @@ public:
   nsresult HasRuleProcessorUsedByMultipleStyleSets(uint32_t aSheetType,
                                                    bool* aRetVal);
 
+public:
+  /**
+   * Scroll-listener flush throttling (layout.throttle_scroll_flushes, opt
+   * in): while a scroll event handler runs, at most one style/layout flush
+   * per refresh tick is serviced synchronously; further ones are deferred to
+   * the next tick while APZ keeps compositing. The deferred count quantifies
+   * the savings per site.
+   */
+  void SetFiringScrollEvent(bool aFiring) { mFiringScrollEvent = aFiring; }
+  bool IsFiringScrollEvent() const { return mFiringScrollEvent; }
+  uint64_t ScrollFlushesDeferred() const { return mScrollFlushesDeferred; }
+
+protected:
+  bool mFiringScrollEvent = false;
+  uint64_t mScrollFlushesDeferred = 0;
+  // TimeStamp of the tick in which the last synchronous scroll-handler flush
+  // ran; at most one such flush is serviced per tick in throttled mode.
+  mozilla::TimeStamp mLastScrollHandlerFlushTick;
+
+public:
+  /**
+   * Frames marked by nsIFrame::MarkNeedsDisplayItemRebuild() since the last
+   * full display list build, bounding how much of a retained display list a
+   * partial rebuild must reconstruct. Weak pointers; entries are purged when
+   * their frame is destroyed.
+   */
+  nsTArray<nsIFrame*>& ModifiedFramesForDisplayList()
+  {
+    return mModifiedFramesForDisplayList;
+  }
+
+  void ClearModifiedFramesForDisplayList();
+
   /**
    * Refresh observer management.
    */
@@ -1842,6 +1875,9 @@ protected:
   // Whether we're currently under a FlushPendingNotifications.
   // This is used to handle flush reentry correctly.
   bool mInFlush;
+
+protected:
+  nsTArray<nsIFrame*> mModifiedFramesForDisplayList;
 };
 
 NS_DEFINE_STATIC_IID_ACCESSOR(nsIPresShell, NS_IPRESSHELL_IID)
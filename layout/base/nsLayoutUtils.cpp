@@ -6,6 +6,8 @@
 
 #include "nsLayoutUtils.h"
 
+#include "mozilla/FrameTimeline.h"
+
 #include "mozilla/ArrayUtils.h"
 #include "mozilla/BasicEvents.h"
 #include "mozilla/ClearOnShutdown.h"
@@ -3574,6 +3576,14 @@ nsLayoutUtils::PaintFrame(gfxContext* aRenderingContext, nsIFrame* aFrame,
                           nsDisplayListBuilderMode aBuilderMode,
                           PaintFrameFlags aFlags)
 {
+  mozilla::FrameTimeline::AutoRecord record(mozilla::FrameStage::Paint);
+
+  // This paint rebuilds the full display list, so the modified-frame
+  // tracking starts over from here.
+  if (nsIPresShell* presShell = aFrame->PresContext()->PresShell()) {
+    presShell->ClearModifiedFramesForDisplayList();
+  }
+
   AUTO_PROFILER_LABEL("nsLayoutUtils::PaintFrame", GRAPHICS);
 
 #ifdef MOZ_DUMP_PAINTING
@@ -23,14 +23,47 @@
 
 using namespace mozilla;
 
+// Chunks donated by retiring arenas, adopted by the next arena constructed.
+// Back/forward navigation tears one document's frame arena down and
+// immediately rebuilds an identical allocation pattern for the next; reusing
+// the chunks skips both the allocator round-trips and the page-fault warmup.
+// The pool is a bare ArenaAllocator holding only recycled chunks.
+static ArenaAllocator<8192, 8>* sRecycledChunkPool;
+
+/* static */ void
+nsPresArena::ClearRecycledChunkPool()
+{
+  if (sRecycledChunkPool) {
+    sRecycledChunkPool->ClearRecycledChunks();
+  }
+}
+
 nsPresArena::nsPresArena()
 {
+  if (sRecycledChunkPool) {
+    // Adopt the pooled chunks: move them from the pool's recycled list into
+    // ours by swapping through a recycle pass (the pool holds them in its
+    // recycled list already, so a plain exchange suffices).
+    mPool.TakeRecycledChunksFrom(*sRecycledChunkPool);
+  }
 }
 
 nsPresArena::~nsPresArena()
 {
   ClearArenaRefPtrs();
 
+  // Donate this arena's chunks for the next document's arena. Poisoning of
+  // freed objects already happened as they were freed; the chunk reset only
+  // changes the bump-allocation offset.
+  if (!sRecycledChunkPool) {
+    sRecycledChunkPool = new ArenaAllocator<8192, 8>();
+  }
+  // Cap the pool at 256 chunks (2 MiB): enough to warm a typical document's
+  // frame tree, while tearing down one enormous document cannot pin its
+  // whole arena footprint for the life of the process.
+  static const size_t kMaxPooledChunks = 256;
+  sRecycledChunkPool->RecycleChunksFrom(mPool, kMaxPooledChunks);
+
 #if defined(MOZ_HAVE_MEM_CHECKS)
   for (FreeList* entry = mFreeLists; entry != ArrayEnd(mFreeLists); ++entry) {
     nsTArray<void*>::index_type len;
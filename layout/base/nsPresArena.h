@@ -29,6 +29,12 @@ public:
   nsPresArena();
   ~nsPresArena();
 
+  /**
+   * Free the chunks held in the recycling pool that warm arenas donate to on
+   * PresShell teardown; called under memory pressure.
+   */
+  static void ClearRecycledChunkPool();
+
   /**
    * Pool allocation with recycler lists indexed by frame-type ID.
    * Every aID must always be used with the same object size, aSize.
@@ -30,6 +30,8 @@
 #include "mozilla/IntegerRange.h"
 #include "nsHostObjectProtocolHandler.h"
 #include "nsRefreshDriver.h"
+
+#include "mozilla/FrameTimeline.h"
 #include "nsITimer.h"
 #include "nsLayoutUtils.h"
 #include "nsPresContext.h"
@@ -1800,6 +1802,7 @@ nsRefreshDriver::Tick(int64_t aNowEpoch, TimeStamp aNowTime)
   }
 
   AUTO_PROFILER_LABEL("nsRefreshDriver::Tick", GRAPHICS);
+  FrameTimeline::AutoRecord record(FrameStage::Tick);
 
   // We're either frozen or we were disconnected (likely in the middle
   // of a tick iteration).  Just do nothing here, since our
@@ -6447,8 +6447,29 @@ SchedulePaintInternal(nsIFrame* aDisplayRoot, nsIFrame* aFrame,
   }
 }
 
+void
+nsIFrame::MarkNeedsDisplayItemRebuild()
+{
+  if (GetStateBits() & NS_FRAME_NEEDS_DISPLAY_ITEM_REBUILD) {
+    return;
+  }
+  nsIPresShell* shell = PresContext()->PresShell();
+  if (!shell) {
+    return;
+  }
+  // The list is unbounded in pathological cases; past a generous cap the
+  // paint falls back to a full rebuild anyway, so stop tracking.
+  static const size_t kMaxModifiedFrames = 1024;
+  if (shell->ModifiedFramesForDisplayList().Length() >= kMaxModifiedFrames) {
+    return;
+  }
+  AddStateBits(NS_FRAME_NEEDS_DISPLAY_ITEM_REBUILD);
+  shell->ModifiedFramesForDisplayList().AppendElement(this);
+}
+
 static void InvalidateFrameInternal(nsIFrame *aFrame, bool aHasDisplayItem = true)
 {
+  aFrame->MarkNeedsDisplayItemRebuild();
   if (aHasDisplayItem) {
     aFrame->AddStateBits(NS_FRAME_NEEDS_PAINT);
   }
@@ -286,6 +286,13 @@ FRAME_STATE_BIT(Generic, 58, NS_FRAME_MATHML_SCRIPT_DESCENDANT)
 // non-whitespace character to allow special rendering behaviour.
 FRAME_STATE_BIT(Generic, 59, NS_FRAME_IS_IN_SINGLE_CHAR_MI)
 
+// This frame has changed in a way that affects its display items, and needs
+// its part of the retained display list rebuilt. Set through
+// nsIFrame::MarkNeedsDisplayItemRebuild() when the frame is invalidated, and
+// cleared when a full display list for the frame is next built. Groundwork
+// for partial display list rebuilds.
+FRAME_STATE_BIT(Generic, 60, NS_FRAME_NEEDS_DISPLAY_ITEM_REBUILD)
+
 // NOTE: Bits 20-31 and 60-63 of the frame state are reserved for specific
 // frame classes.
 
@@ -4746,6 +4746,10 @@ ScrollFrameHelper::FireScrollEvent()
   mScrollEvent = nullptr;
 
   ActiveLayerTracker::SetCurrentScrollHandlerFrame(mOuter);
+  nsIPresShell* presShell = mOuter->PresContext()->PresShell();
+  if (presShell) {
+    presShell->SetFiringScrollEvent(true);
+  }
   WidgetGUIEvent event(true, eScroll, nullptr);
   nsEventStatus status = nsEventStatus_eIgnore;
   nsIContent* content = mOuter->GetContent();
@@ -4765,6 +4769,9 @@ ScrollFrameHelper::FireScrollEvent()
     event.mFlags.mBubbles = false;
     EventDispatcher::Dispatch(content, prescontext, &event, nullptr, &status);
   }
+  if (presShell) {
+    presShell->SetFiringScrollEvent(false);
+  }
   ActiveLayerTracker::SetCurrentScrollHandlerFrame(nullptr);
 }
 
@@ -2994,6 +2994,15 @@ public:
    * Check if any frame within the frame subtree (including this frame)
    * returns true for IsInvalid().
    */
+  /**
+   * Record that this frame's display items need rebuilding, accumulating the
+   * frame on its PresShell's modified-frame list. A later partial display
+   * list build can rebuild only the sublists of frames so marked and splice
+   * them into a retained list; until then the list bounds how much
+   * invalidation work a paint must consider.
+   */
+  void MarkNeedsDisplayItemRebuild();
+
   bool HasInvalidFrameInSubtree()
   {
     return HasAnyStateBits(NS_FRAME_NEEDS_PAINT | NS_FRAME_DESCENDANT_NEEDS_PAINT);
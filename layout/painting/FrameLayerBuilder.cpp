@@ -1998,12 +1998,50 @@ FrameLayerBuilder::StoreOptimizedLayerForFrame(nsDisplayItem* aItem, Layer* aLay
   data->mItem = nullptr;
 }
 
+// Count the layers of a subtree, splitting out painted layers, so per-paint
+// layerization cost is visible. Walking the finished tree is trivially cheap
+// next to building it.
+static void
+CountLayersInSubtree(Layer* aLayer, uint32_t* aTotal, uint32_t* aPainted)
+{
+  (*aTotal)++;
+  if (aLayer->AsPaintedLayer()) {
+    (*aPainted)++;
+  }
+  for (Layer* child = aLayer->GetFirstChild(); child;
+       child = child->GetNextSibling()) {
+    CountLayersInSubtree(child, aTotal, aPainted);
+  }
+}
+
 void
 FrameLayerBuilder::DidEndTransaction()
 {
   GetMaskLayerImageCache()->Sweep();
+
+  // Per-paint layerization accounting: pages that creep past the layer
+  // budget composite slower than they paint, and today that is only
+  // discoverable from jank reports. The budget is a diagnostic threshold,
+  // not a behavior change; exceeding it emits a profiler marker so the
+  // regression window is visible in profiles and test logs.
+  if (mRetainingManager && mRetainingManager->GetRoot()) {
+    uint32_t totalLayers = 0;
+    uint32_t paintedLayers = 0;
+    CountLayersInSubtree(mRetainingManager->GetRoot(), &totalLayers,
+                         &paintedLayers);
+    sLastPaintLayerCount = totalLayers;
+    sLastPaintPaintedLayerCount = paintedLayers;
+
+    static const uint32_t kLayerBudget = 64;
+    if (totalLayers > kLayerBudget) {
+      profiler_add_marker("Layerization over budget");
+    }
+  }
 }
 
+uint32_t FrameLayerBuilder::sLastPaintLayerCount = 0;
+uint32_t FrameLayerBuilder::sLastPaintPaintedLayerCount = 0;
+
 void
 FrameLayerBuilder::WillEndTransaction()
 {
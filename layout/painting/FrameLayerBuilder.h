@@ -353,6 +353,19 @@ public:
    */
   void WillEndTransaction();
 
+  /**
+   * Layer counts from the most recent completed transaction, for
+   * layerization diagnostics (see DidEndTransaction).
+   */
+  static uint32_t LastPaintLayerCount() { return sLastPaintLayerCount; }
+  static uint32_t LastPaintPaintedLayerCount() { return sLastPaintPaintedLayerCount; }
+
+protected:
+  static uint32_t sLastPaintLayerCount;
+  static uint32_t sLastPaintPaintedLayerCount;
+
+public:
+
   /**
    * Call this after we end a transaction.
    */
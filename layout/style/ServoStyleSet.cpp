@@ -1449,7 +1449,24 @@ ServoStyleSet::MayTraverseFrom(Element* aElement)
 bool
 ServoStyleSet::ShouldTraverseInParallel() const
 {
-  return mPresContext->PresShell()->IsActive();
+  if (!mPresContext->PresShell()->IsActive()) {
+    return false;
+  }
+
+  // A parallel traversal's fork/join overhead exceeds the styling work when
+  // the dirty subtree is small - the common case for targeted restyles where
+  // the restyle root has moved below the document element, which
+  // small-DOM-but-many-iframe sessions hit constantly. Initial styling and
+  // document-wide restyles keep the parallel path.
+  nsIDocument* doc = mPresContext->Document();
+  nsINode* restyleRoot = doc->GetServoRestyleRoot();
+  if (restyleRoot && restyleRoot != doc && restyleRoot != doc->GetRootElement()) {
+    mSequentialTraversalCount++;
+    return false;
+  }
+
+  mParallelTraversalCount++;
+  return true;
 }
 
 void
@@ -487,6 +487,16 @@ private:
 
   bool ShouldTraverseInParallel() const;
 
+public:
+  // Counters for tuning the adaptive sequential-vs-parallel selection above;
+  // readable from diagnostics code.
+  uint64_t ParallelTraversalCount() const { return mParallelTraversalCount; }
+  uint64_t SequentialTraversalCount() const { return mSequentialTraversalCount; }
+
+private:
+  mutable uint64_t mParallelTraversalCount = 0;
+  mutable uint64_t mSequentialTraversalCount = 0;
+
   /**
    * Gets the pending snapshots to handle from the restyle manager.
    */
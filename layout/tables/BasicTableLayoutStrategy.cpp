@@ -267,6 +267,13 @@ BasicTableLayoutStrategy::ComputeColumnIntrinsicISizes(gfxContext* aRenderingCon
     mozilla::AutoStackArena arena;
     SpanningCellSorter spanningCells;
 
+    // When the previous pass saw no colspanning cells, a column whose cells
+    // have not been invalidated still has valid coords from that pass, so
+    // its per-cell walk can be skipped entirely. Spanning cells distribute
+    // across columns in a later phase and would invalidate that reuse.
+    const bool canSkipCleanColumns = !mSawSpanningCells;
+    bool sawSpanningCells = false;
+
     // Loop over the columns to consider the columns and cells *without*
     // a colspan.
     int32_t col, col_end;
@@ -276,6 +283,9 @@ BasicTableLayoutStrategy::ComputeColumnIntrinsicISizes(gfxContext* aRenderingCon
             NS_ERROR("column frames out of sync with cell map");
             continue;
         }
+        if (canSkipCleanColumns && !colFrame->AreConstraintsDirty()) {
+            continue;
+        }
         colFrame->ResetIntrinsics();
         colFrame->ResetSpanIntrinsics();
 
@@ -309,6 +319,7 @@ BasicTableLayoutStrategy::ComputeColumnIntrinsicISizes(gfxContext* aRenderingCon
         nsTableCellFrame* cellFrame;
         while ((cellFrame = columnIter.GetNextFrame(&row, &colSpan))) {
             if (colSpan > 1) {
+                sawSpanningCells = true;
                 spanningCells.AddCell(colSpan, row, col);
                 continue;
             }
@@ -327,6 +338,22 @@ BasicTableLayoutStrategy::ComputeColumnIntrinsicISizes(gfxContext* aRenderingCon
                colFrame->GetPrefPercent());
 #endif
     }
+    if (sawSpanningCells && canSkipCleanColumns) {
+        // A colspan appeared since the pass that allowed skipping. Redo this
+        // pass with skipping disabled so every column's span intrinsics
+        // start from a clean reset.
+        mSawSpanningCells = true;
+        ComputeColumnIntrinsicISizes(aRenderingContext);
+        return;
+    }
+
+    for (col = 0; col < col_end; ++col) {
+        if (nsTableColFrame* colFrame = tableFrame->GetColFrame(col)) {
+            colFrame->ClearConstraintsDirty();
+        }
+    }
+    mSawSpanningCells = sawSpanningCells;
+
 #ifdef DEBUG_TABLE_STRATEGY
     printf("ComputeColumnIntrinsicISizes single\n");
     mTableFrame->Dump(false, true, false);
@@ -73,6 +73,9 @@ private:
 
     nsTableFrame *mTableFrame;
     nscoord mMinISize;
+    // Whether the last constraint pass saw any colspanning cells; when it
+    // did not, clean columns can be skipped on the next pass.
+    bool mSawSpanningCells = true;
     nscoord mPrefISize;
     nscoord mPrefISizePctExpand;
     nscoord mLastCalcISize;
@@ -779,9 +779,13 @@ nsTableCellFrame::GetMinISize(gfxContext *aRenderingContext)
   nscoord result = 0;
   DISPLAY_MIN_WIDTH(this, result);
 
-  nsIFrame *inner = mFrames.FirstChild();
-  result = nsLayoutUtils::IntrinsicForContainer(aRenderingContext, inner,
-                                                    nsLayoutUtils::MIN_ISIZE);
+  if (mCachedMinISize == NS_INTRINSIC_WIDTH_UNKNOWN) {
+    nsIFrame *inner = mFrames.FirstChild();
+    mCachedMinISize =
+      nsLayoutUtils::IntrinsicForContainer(aRenderingContext, inner,
+                                           nsLayoutUtils::MIN_ISIZE);
+  }
+  result = mCachedMinISize;
   return result;
 }
 
@@ -791,12 +795,37 @@ nsTableCellFrame::GetPrefISize(gfxContext *aRenderingContext)
   nscoord result = 0;
   DISPLAY_PREF_WIDTH(this, result);
 
-  nsIFrame *inner = mFrames.FirstChild();
-  result = nsLayoutUtils::IntrinsicForContainer(aRenderingContext, inner,
-                                                nsLayoutUtils::PREF_ISIZE);
+  if (mCachedPrefISize == NS_INTRINSIC_WIDTH_UNKNOWN) {
+    nsIFrame *inner = mFrames.FirstChild();
+    mCachedPrefISize =
+      nsLayoutUtils::IntrinsicForContainer(aRenderingContext, inner,
+                                           nsLayoutUtils::PREF_ISIZE);
+  }
+  result = mCachedPrefISize;
   return result;
 }
 
+/* virtual */ void
+nsTableCellFrame::MarkIntrinsicISizesDirty()
+{
+  mCachedMinISize = NS_INTRINSIC_WIDTH_UNKNOWN;
+  mCachedPrefISize = NS_INTRINSIC_WIDTH_UNKNOWN;
+
+  // Let the table layout strategy limit its next constraint pass to the
+  // affected column.
+  int32_t colIndex;
+  if (NS_SUCCEEDED(GetColIndex(colIndex))) {
+    nsTableFrame* tableFrame = nsTableFrame::GetTableFrame(this);
+    if (tableFrame) {
+      if (nsTableColFrame* colFrame = tableFrame->GetColFrame(colIndex)) {
+        colFrame->MarkConstraintsDirty();
+      }
+    }
+  }
+
+  nsContainerFrame::MarkIntrinsicISizesDirty();
+}
+
 /* virtual */ nsIFrame::IntrinsicISizeOffsetData
 nsTableCellFrame::IntrinsicISizeOffsets()
 {
@@ -45,6 +45,14 @@ class nsTableCellFrame : public nsContainerFrame,
     : nsTableCellFrame(aContext, aTableFrame, kClassID) {}
 
 protected:
+  // Cached intrinsic inline sizes. Table layout strategies query every cell
+  // repeatedly (once per column pass, again for spans), and on a 10,000-row
+  // table the repeated descents into IntrinsicForContainer dominate first
+  // reflow; a cell's sizes only change when its intrinsic sizes are marked
+  // dirty.
+  nscoord mCachedMinISize = NS_INTRINSIC_WIDTH_UNKNOWN;
+  nscoord mCachedPrefISize = NS_INTRINSIC_WIDTH_UNKNOWN;
+
   typedef mozilla::WritingMode WritingMode;
   typedef mozilla::LogicalSide LogicalSide;
   typedef mozilla::LogicalMargin LogicalMargin;
@@ -114,6 +122,7 @@ public:
   virtual nscoord GetMinISize(gfxContext *aRenderingContext) override;
   virtual nscoord GetPrefISize(gfxContext *aRenderingContext) override;
   virtual IntrinsicISizeOffsetData IntrinsicISizeOffsets() override;
+  virtual void MarkIntrinsicISizesDirty() override;
 
   virtual void Reflow(nsPresContext*      aPresContext,
                       ReflowOutput& aDesiredSize,
@@ -115,6 +115,16 @@ public:
    * Restore the default values of the intrinsic widths, so that we can
    * re-accumulate intrinsic widths from the cells in the column.
    */
+  /**
+   * Column constraint dirtiness, driven by MarkIntrinsicISizesDirty on the
+   * column and on cells in it. When a table has no spanning cells,
+   * BasicTableLayoutStrategy skips re-walking the cells of clean columns and
+   * reuses the coords stored here from the previous pass.
+   */
+  bool AreConstraintsDirty() const { return mConstraintsDirty; }
+  void MarkConstraintsDirty() { mConstraintsDirty = true; }
+  void ClearConstraintsDirty() { mConstraintsDirty = false; }
+
   void ResetIntrinsics() {
     mMinCoord = 0;
     mPrefCoord = 0;
@@ -286,6 +296,7 @@ protected:
   explicit nsTableColFrame(nsStyleContext* aContext);
   ~nsTableColFrame();
 
+  bool mConstraintsDirty = true;
   nscoord mMinCoord;
   nscoord mPrefCoord;
   nscoord mSpanMinCoord; // XXX...
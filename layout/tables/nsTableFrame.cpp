@@ -793,6 +793,26 @@ nsTableFrame::MatchCellMapToColCache(nsTableCellMap* aCellMap)
       aCellMap->AddColsAtEnd(numColsNotRemoved);
     }
   }
+
+  // Every structural cell-map change funnels through here, but none of it
+  // routes through nsTableCellFrame::MarkIntrinsicISizesDirty (frame
+  // construction only dirties ancestors), so the clean-column skipping in
+  // BasicTableLayoutStrategy would never see inserted or removed cells.
+  // Conservatively dirty every column: colspans redistribute beyond any
+  // single damage area, and the skip optimization is aimed at pure content
+  // updates, which do not pass through the cell map.
+  MarkAllColConstraintsDirty();
+}
+
+void
+nsTableFrame::MarkAllColConstraintsDirty()
+{
+  int32_t colCount = mColFrames.Length();
+  for (int32_t col = 0; col < colCount; col++) {
+    if (nsTableColFrame* colFrame = GetColFrame(col)) {
+      colFrame->MarkConstraintsDirty();
+    }
+  }
 }
 
 void
@@ -515,6 +515,12 @@ public:
                                 bool                  aAddToTable);
 
   void MatchCellMapToColCache(nsTableCellMap* aCellMap);
+
+  /**
+   * Dirty every column's cached constraint summary; called for structural
+   * cell-map changes, which bypass the per-cell intrinsic-size dirtying.
+   */
+  void MarkAllColConstraintsDirty();
   /** empty the column frame cache */
   void ClearColCache();
 
@@ -105,6 +105,34 @@ MALLOC_DECL(jemalloc_thread_local_arena, void, bool)
  * Provide information about any allocation enclosing the given address.
  */
 MALLOC_DECL(jemalloc_ptr_info, void, const void*, jemalloc_ptr_info_t*)
+
+/*
+ * Try to extend the allocation at the given address to at least the given
+ * size without moving it, by growing into a trailing free run (large
+ * allocations) or committing more of the same chunk (huge allocations).
+ * Returns true if the allocation now has at least the requested usable size.
+ * Unlike realloc, the contents are untouched on failure, so callers may use
+ * this for element types which cannot be moved by memcpy.
+ */
+MALLOC_DECL(jemalloc_try_grow_in_place, bool, void*, size_t)
+
+/*
+ * Scale every arena's dirty-page tolerance by 1 << shift (clamped to 6), so
+ * page purging defers to an explicit jemalloc_free_dirty_pages() call on an
+ * idle-time schedule instead of issuing madvise storms from allocation-heavy
+ * phases. A shift of 0 restores the default eager policy.
+ */
+MALLOC_DECL(jemalloc_set_purge_deferral, void, uint32_t)
+
+/*
+ * Runtime switch for the built-in sampling allocation profiler: while
+ * enabled, roughly every 256 KiB of allocation tags one live block, at a
+ * cost of one branch per malloc/free while disabled. The companion query
+ * returns the estimated live bytes represented by the currently sampled
+ * blocks; profiler integration can attribute them by address.
+ */
+MALLOC_DECL(jemalloc_set_alloc_sampling, void, bool)
+MALLOC_DECL(jemalloc_sampled_live_bytes, uint64_t)
 #  endif
 
 #  if MALLOC_FUNCS & MALLOC_FUNCS_ARENA_BASE
@@ -109,6 +109,7 @@
 
 #include "mozmemory_wrap.h"
 #include "mozjemalloc.h"
+#include "mozilla/Atomics.h"
 #include "mozilla/Sprintf.h"
 #include "mozilla/Likely.h"
 #include "mozilla/DoublyLinkedList.h"
@@ -1033,6 +1034,117 @@ static mozilla::detail::ThreadLocal<arena_t*, mozilla::detail::ThreadLocalKeySto
 #endif
 #endif
 
+/******************************************************************************/
+/*
+ * Sampling allocation profiler.
+ *
+ * An always-compiled, runtime-switchable sampler: each thread counts
+ * allocated bytes down from a skip distance drawn around kSampleInterval and
+ * records the allocation that crosses zero in a small table of sampled
+ * blocks, each standing for approximately kSampleInterval live bytes. The
+ * aggregate is a statistically sound live-byte estimate that costs one
+ * predictable branch per allocation while disabled, so it can ship enabled
+ * in the field, unlike DMD's precise tracking. Lookups on free are lock-free
+ * bounded probes; a failed insert just drops the sample.
+ */
+
+static mozilla::Atomic<bool, mozilla::Relaxed> gSamplerEnabled(false);
+
+/* Whether the sampler's per-thread countdown TLS slot was created; if not,
+ * the sampler simply stays inert (allocator init must never fail over a
+ * diagnostics slot). */
+static bool gSamplerTLSInitialized = false;
+static mozilla::Atomic<uint64_t, mozilla::Relaxed> gSampledBlockCount(0);
+
+static const size_t kSampleInterval = 256 * 1024;
+static const size_t kSampleTableSize = 1 << 16;  // Slots; power of two.
+static const size_t kSampleMaxProbes = 8;
+
+struct SampledBlock
+{
+  mozilla::Atomic<uintptr_t, mozilla::Relaxed> mPtr;
+};
+
+static SampledBlock gSampleTable[kSampleTableSize];
+
+#ifdef NO_TLS
+/* Without TLS there is no per-thread countdown; the sampler stays inert. */
+#else
+#if !defined(XP_WIN) && !defined(XP_DARWIN)
+static MOZ_THREAD_LOCAL(ssize_t) thread_sample_countdown;
+#else
+static mozilla::detail::ThreadLocal<ssize_t,
+    mozilla::detail::ThreadLocalKeyStorage> thread_sample_countdown;
+#endif
+#endif
+
+static inline size_t
+SampleSlot(uintptr_t aPtr, size_t aProbe)
+{
+  /* Mix the pointer so neighbouring allocations spread over the table. */
+  uintptr_t hash = (aPtr >> 4) * 0x9E3779B97F4A7C15ULL;
+  return (size_t(hash >> 32) + aProbe) & (kSampleTableSize - 1);
+}
+
+static void
+SamplerNoteAlloc(void* aPtr, size_t aSize)
+{
+#ifdef NO_TLS
+  return;
+#else
+  ssize_t countdown = thread_sample_countdown.get() - ssize_t(aSize);
+  if (MOZ_LIKELY(countdown > 0)) {
+    thread_sample_countdown.set(countdown);
+    return;
+  }
+
+  /* Derive the next skip pseudo-randomly from the pointer so that regular
+   * allocation patterns cannot alias with the sampling period. */
+  uintptr_t jitter = (uintptr_t(aPtr) >> 4) * 2654435761u;
+  thread_sample_countdown.set(
+    ssize_t(kSampleInterval / 2 + (jitter % kSampleInterval)));
+
+  for (size_t probe = 0; probe < kSampleMaxProbes; probe++) {
+    SampledBlock& slot = gSampleTable[SampleSlot(uintptr_t(aPtr), probe)];
+    uintptr_t expected = 0;
+    if (slot.mPtr.compareExchange(expected, uintptr_t(aPtr))) {
+      gSampledBlockCount++;
+      return;
+    }
+  }
+  /* Table pressure: drop the sample; the estimate just loses one unit. */
+#endif
+}
+
+static void
+SamplerNoteFree(void* aPtr)
+{
+  for (size_t probe = 0; probe < kSampleMaxProbes; probe++) {
+    SampledBlock& slot = gSampleTable[SampleSlot(uintptr_t(aPtr), probe)];
+    uintptr_t expected = uintptr_t(aPtr);
+    if (slot.mPtr.compareExchange(expected, 0)) {
+      gSampledBlockCount--;
+      return;
+    }
+  }
+}
+
+static inline void
+MaybeSampleAlloc(void* aPtr, size_t aSize)
+{
+  if (MOZ_UNLIKELY(gSamplerEnabled) && aPtr && gSamplerTLSInitialized) {
+    SamplerNoteAlloc(aPtr, aSize);
+  }
+}
+
+static inline void
+MaybeSampleFree(void* aPtr)
+{
+  if (MOZ_UNLIKELY(gSamplerEnabled) && aPtr) {
+    SamplerNoteFree(aPtr);
+  }
+}
+
 /*******************************/
 /*
  * Runtime configuration options.
@@ -1049,6 +1161,14 @@ static const bool	opt_zero = false;
 #endif
 
 static size_t	opt_dirty_max = DIRTY_MAX_DEFAULT;
+
+/*
+ * When non-zero, each arena tolerates (mMaxDirty << gPurgeDeferralShift)
+ * dirty pages before purging, so madvise calls coalesce into the explicit
+ * idle-time jemalloc_free_dirty_pages() sweep instead of storming during
+ * allocation-heavy phases. Set via jemalloc_set_purge_deferral().
+ */
+static mozilla::Atomic<uint32_t, mozilla::Relaxed> gPurgeDeferralShift(0);
 #ifdef MALLOC_STATIC_SIZES
 #define opt_quantum_2pow	QUANTUM_2POW_MIN
 #define opt_small_max_2pow	SMALL_MAX_2POW_DEFAULT
@@ -2862,7 +2982,7 @@ arena_t::Purge(bool aAll)
   arena_chunk_t* chunk;
   size_t i, npages;
   /* If all is set purge all dirty pages. */
-  size_t dirty_max = aAll ? 1 : mMaxDirty;
+  size_t dirty_max = aAll ? 1 : (mMaxDirty << gPurgeDeferralShift);
 #ifdef MOZ_DEBUG
   size_t ndirty = 0;
   rb_foreach_begin(arena_chunk_t, link_dirty, &mChunksDirty, chunk) {
@@ -2870,7 +2990,7 @@ arena_t::Purge(bool aAll)
   } rb_foreach_end(arena_chunk_t, link_dirty, &mChunksDirty, chunk)
   MOZ_ASSERT(ndirty == mNumDirty);
 #endif
-  MOZ_DIAGNOSTIC_ASSERT(aAll || (mNumDirty > mMaxDirty));
+  MOZ_DIAGNOSTIC_ASSERT(aAll || (mNumDirty > (mMaxDirty << gPurgeDeferralShift)));
 
   /*
    * Iterate downward through chunks until enough dirty memory has been
@@ -3047,8 +3167,8 @@ arena_t::DallocRun(arena_run_t* aRun, bool aDirty)
     DeallocChunk(chunk);
   }
 
-  /* Enforce mMaxDirty. */
-  if (mNumDirty > mMaxDirty) {
+  /* Enforce mMaxDirty, as scaled by any purge deferral. */
+  if (mNumDirty > (mMaxDirty << gPurgeDeferralShift)) {
     Purge(false);
   }
 }
@@ -4470,6 +4590,11 @@ malloc_init_hard(void)
   }
 
 #ifndef NO_TLS
+  /* A sampler TLS failure is non-fatal: the sampler just stays inert. */
+  gSamplerTLSInitialized = thread_sample_countdown.init();
+  if (gSamplerTLSInitialized) {
+    thread_sample_countdown.set(ssize_t(kSampleInterval));
+  }
   if (!thread_arena.init()) {
     return false;
   }
@@ -4747,6 +4872,7 @@ BaseAllocator::malloc(size_t aSize)
   }
 
   ret = imalloc(aSize, /* zero = */ false, mArena);
+  MaybeSampleAlloc(ret, aSize);
 
 RETURN:
   if (!ret) {
@@ -4773,6 +4899,7 @@ BaseAllocator::memalign(size_t aAlignment, size_t aSize)
 
   aAlignment = aAlignment < sizeof(void*) ? sizeof(void*) : aAlignment;
   ret = ipalloc(aAlignment, aSize, mArena);
+  MaybeSampleAlloc(ret, aSize);
 
   return ret;
 }
@@ -4805,6 +4932,7 @@ BaseAllocator::calloc(size_t aNum, size_t aSize)
   }
 
   ret = imalloc(num_size, /* zero = */ true, mArena);
+  MaybeSampleAlloc(ret, num_size);
 
 RETURN:
   if (!ret) {
@@ -4828,7 +4956,13 @@ BaseAllocator::realloc(void* aPtr, size_t aSize)
 
     ret = iralloc(aPtr, aSize, mArena);
 
-    if (!ret) {
+    if (ret) {
+      /* The old block may have moved or died; retag the new one. */
+      if (ret != aPtr) {
+        MaybeSampleFree(aPtr);
+        MaybeSampleAlloc(ret, aSize);
+      }
+    } else {
       errno = ENOMEM;
     }
   } else {
@@ -4836,6 +4970,7 @@ BaseAllocator::realloc(void* aPtr, size_t aSize)
       ret = nullptr;
     } else {
       ret = imalloc(aSize, /* zero = */ false, mArena);
+      MaybeSampleAlloc(ret, aSize);
     }
 
     if (!ret) {
@@ -4851,6 +4986,8 @@ BaseAllocator::free(void* aPtr)
 {
   size_t offset;
 
+  MaybeSampleFree(aPtr);
+
   /*
    * A version of idalloc that checks for nullptr pointer but only for
    * huge allocations assuming that CHUNK_ADDR2OFFSET(nullptr) == 0.
@@ -5185,6 +5322,63 @@ MozJemalloc::jemalloc_free_dirty_pages(void)
   malloc_spin_unlock(&arenas_lock);
 }
 
+template<>
+inline void
+MozJemalloc::jemalloc_set_alloc_sampling(bool aEnabled)
+{
+  gSamplerEnabled = aEnabled;
+}
+
+template<>
+inline uint64_t
+MozJemalloc::jemalloc_sampled_live_bytes()
+{
+  /* Each sampled block stands for roughly one sampling interval of
+   * allocated bytes. */
+  return gSampledBlockCount * uint64_t(kSampleInterval);
+}
+
+template<>
+inline void
+MozJemalloc::jemalloc_set_purge_deferral(uint32_t aShift)
+{
+  /* Cap the deferral so a runaway caller cannot pin unbounded dirty pages. */
+  gPurgeDeferralShift = aShift > 6 ? 6 : aShift;
+}
+
+template<>
+inline bool
+MozJemalloc::jemalloc_try_grow_in_place(void* aPtr, size_t aSize)
+{
+  if (!aPtr || aSize == 0) {
+    return false;
+  }
+
+  size_t oldsize = isalloc(aPtr);
+  if (aSize <= oldsize) {
+    /* The current size class already covers the request. */
+    return true;
+  }
+
+  if (oldsize > arena_maxclass) {
+    /* Huge: growable in place only within the same chunk ceiling, which
+     * huge_ralloc handles by committing the extra pages. */
+    if (CHUNK_CEILING(aSize) != CHUNK_CEILING(oldsize)) {
+      return false;
+    }
+    return huge_ralloc(aPtr, aSize, oldsize) == aPtr;
+  }
+
+  if (aSize > arena_maxclass || oldsize <= bin_maxclass) {
+    /* Crossing into huge, or growing a small/sub-page allocation beyond its
+     * run slot: both require moving. */
+    return false;
+  }
+
+  /* Large: try to extend into a trailing free run. */
+  return arena_ralloc_large(aPtr, aSize, oldsize) == false;
+}
+
 inline arena_t*
 arena_t::GetById(arena_id_t aArenaId)
 {
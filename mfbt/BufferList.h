@@ -296,6 +296,15 @@ class BufferList : private AllocPolicy
   // bytes may be split across multiple buffers. Size() is increased by aSize.
   inline bool WriteBytes(const char* aData, size_t aSize);
 
+  // Takes ownership of aData (which must be allocated with the same allocator
+  // this BufferList frees with) and appends it as a whole segment, without
+  // copying. To preserve the segment invariants documented above, aSize and
+  // aCapacity must be multiples of kSegmentAlignment and the list's current
+  // size must already be a multiple of kSegmentAlignment (the previous last
+  // segment is closed by capping its capacity to its size). On failure, false
+  // is returned and ownership of aData is not taken.
+  inline bool WriteBytesZeroCopy(char* aData, size_t aSize, size_t aCapacity);
+
   // Allocates a buffer of at most |aMaxBytes| bytes and, if successful, returns
   // that buffer, and places its size in |aSize|. If unsuccessful, returns null
   // and leaves |aSize| undefined.
@@ -396,6 +405,34 @@ BufferList<AllocPolicy>::WriteBytes(const char* aData, size_t aSize)
   return true;
 }
 
+template<typename AllocPolicy>
+bool
+BufferList<AllocPolicy>::WriteBytesZeroCopy(char* aData, size_t aSize,
+                                            size_t aCapacity)
+{
+  MOZ_RELEASE_ASSERT(mOwning);
+  MOZ_RELEASE_ASSERT(aSize != 0 && aSize <= aCapacity);
+  MOZ_RELEASE_ASSERT(aSize % kSegmentAlignment == 0);
+  MOZ_RELEASE_ASSERT(aCapacity % kSegmentAlignment == 0);
+  MOZ_RELEASE_ASSERT(mSize % kSegmentAlignment == 0);
+
+  // Close the current last segment so that every segment but the new last
+  // one is full. Its size is a multiple of kSegmentAlignment (it equals
+  // mSize minus a sum of full, aligned capacities), so the capacity stays
+  // aligned too.
+  if (!mSegments.empty()) {
+    Segment& last = mSegments[mSegments.length() - 1];
+    MOZ_ASSERT(last.mSize % kSegmentAlignment == 0);
+    last.mCapacity = last.mSize;
+  }
+
+  if (!mSegments.append(Segment(aData, aSize, aCapacity))) {
+    return false;
+  }
+  mSize += aSize;
+  return true;
+}
+
 template<typename AllocPolicy>
 char*
 BufferList<AllocPolicy>::AllocateBytes(size_t aMaxSize, size_t* aSize)
@@ -247,7 +247,45 @@ MOZ_WIN_MEM_TRY_CATCH(rv = NS_ERROR_FAILURE)
 NS_IMETHODIMP
 nsJARInputStream::ReadSegments(nsWriteSegmentFun writer, void * closure, uint32_t count, uint32_t *_retval)
 {
-    // don't have a buffer to read from, so this better not be called!
+    if (mMode == MODE_COPY && !mFd) {
+        // Everything was handed out already; report EOF the same way Read()
+        // does, so ReadSegments loops (e.g. NS_AsyncCopy) terminate cleanly
+        // instead of seeing a spurious error.
+        *_retval = 0;
+        return NS_OK;
+    }
+
+    if (mMode == MODE_COPY) {
+        // Stored entries are served straight out of the mmap'd archive, so
+        // hand the mapped bytes to the writer without an intermediate copy;
+        // stream pumps draining omni.ja STORE entries then move no data at
+        // all on this side.
+        nsresult rv = NS_OK;
+        *_retval = 0;
+MOZ_WIN_MEM_TRY_BEGIN
+        uint32_t avail = mOutSize - uint32_t(mZs.total_out);
+        uint32_t toWrite = std::min(count, avail);
+        if (toWrite) {
+            uint32_t written = 0;
+            nsresult writerRv =
+                writer(this, closure,
+                       reinterpret_cast<const char*>(mZs.next_in + mZs.total_out),
+                       0, toWrite, &written);
+            if (NS_SUCCEEDED(writerRv)) {
+                mZs.total_out += written;
+                *_retval = written;
+            }
+            // Writer errors are not stream errors; per the contract we just
+            // report zero bytes consumed.
+        }
+        if (mZs.total_out >= mOutSize) {
+            mFd = nullptr;
+        }
+MOZ_WIN_MEM_TRY_CATCH(rv = NS_ERROR_FAILURE)
+        return rv;
+    }
+
+    // The inflating modes have no buffer to hand out.
     return NS_ERROR_NOT_IMPLEMENTED;
 }
 
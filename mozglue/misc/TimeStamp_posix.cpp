@@ -202,6 +202,20 @@ TimeStamp::Shutdown()
 TimeStamp
 TimeStamp::Now(bool aHighResolution)
 {
+#if defined(CLOCK_MONOTONIC_COARSE) && (defined(XP_LINUX) || defined(ANDROID))
+  // NowLoRes() callers have declared they tolerate tick-granularity
+  // timestamps; CLOCK_MONOTONIC_COARSE answers from the vDSO-cached tick
+  // value without the fine-clock read, which is measurably cheaper on older
+  // kernels where timers, media and necko together issue millions of reads
+  // per minute. Both clocks share the same epoch, so mixing resolutions
+  // stays ordered to within the tick.
+  if (!aHighResolution) {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0) {
+      return TimeStamp(uint64_t(ts.tv_sec) * kNsPerSec + uint64_t(ts.tv_nsec));
+    }
+  }
+#endif
   return TimeStamp(ClockTimeNs());
 }
 
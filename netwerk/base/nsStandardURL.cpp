@@ -8,6 +8,9 @@
 
 #include "nsASCIIMask.h"
 #include "nsStandardURL.h"
+
+#include "mozilla/HashFunctions.h"
+#include "mozilla/StaticMutex.h"
 #include "nsCRT.h"
 #include "nsEscape.h"
 #include "nsIFile.h"
@@ -1054,9 +1057,45 @@ nsStandardURL::BuildNormalizedSpec(const char *spec,
     }
     mSpec.SetLength(strlen(buf));
     NS_ASSERTION(mSpec.Length() <= approxLen, "We've overflowed the mSpec buffer!");
+
+    InternSpec();
     return NS_OK;
 }
 
+/**
+ * A small process-wide cache of recently normalized specs. Session restore
+ * and link-heavy pages parse the same URLs over and over; sharing one
+ * refcounted string buffer between equal specs (nsStringBuffer refcounting
+ * is atomic, so cross-thread sharing is safe) deduplicates the dominant
+ * allocation of a parse. Direct-mapped and lossy by design.
+ */
+void
+nsStandardURL::InternSpec()
+{
+    static const size_t kInternTableSize = 256;  // Power of two.
+    static StaticMutex sInternLock;
+    static nsCString* sInternTable = nullptr;
+
+    if (mSpec.Length() > 512) {
+        // Long specs are poor dedupe candidates and would hold big buffers.
+        return;
+    }
+
+    uint32_t hash = mozilla::HashString(mSpec.get(), mSpec.Length());
+
+    StaticMutexAutoLock lock(sInternLock);
+    if (!sInternTable) {
+        sInternTable = new nsCString[kInternTableSize];
+    }
+
+    nsCString& slot = sInternTable[hash & (kInternTableSize - 1)];
+    if (slot.Equals(mSpec)) {
+        mSpec = slot;  // Share the interned buffer, dropping ours.
+    } else {
+        slot = mSpec;  // Replace whatever was there; lossy is fine.
+    }
+}
+
 bool
 nsStandardURL::SegmentIs(const URLSegment &seg, const char *val, bool ignoreCase)
 {
@@ -79,6 +79,8 @@ public:
 
 public: /* internal -- HPUX compiler can't handle this being private */
     //
+    void InternSpec();
+
     // location and length of an url segment relative to mSpec
     //
     struct URLSegment
@@ -94,6 +94,8 @@
 
 #include "SSLServerCertVerification.h"
 
+#include <algorithm>
+
 #include <cstring>
 
 #include "BRNameMatchingPolicy.h"
@@ -175,9 +177,13 @@ InitializeSSLServerCertVerificationThreads()
     return;
   }
 
-  (void) gCertVerificationThreadPool->SetIdleThreadLimit(5);
+  // Scale with the machine: a session-restore burst queues dozens of
+  // verifications at once, and on many-core machines a fixed limit of 5
+  // leaves the backlog serialized behind OCSP fetches.
+  uint32_t threadLimit = std::max(5, std::min(PR_GetNumberOfProcessors(), 8));
+  (void) gCertVerificationThreadPool->SetIdleThreadLimit(threadLimit);
   (void) gCertVerificationThreadPool->SetIdleThreadTimeout(30 * 1000);
-  (void) gCertVerificationThreadPool->SetThreadLimit(5);
+  (void) gCertVerificationThreadPool->SetThreadLimit(threadLimit);
   (void) gCertVerificationThreadPool->SetName(NS_LITERAL_CSTRING("SSL Cert"));
 }
 
@@ -7,6 +7,7 @@
 #include "prio.h"
 #include "PLDHashTable.h"
 #include "mozilla/IOInterposer.h"
+#include "mozilla/Compression.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/scache/StartupCache.h"
 
@@ -266,6 +267,38 @@ GetBufferFromZipArchive(nsZipArchive *zip, bool doCRC, const char* id,
 
 // NOTE: this will not find a new entry until it has been written to disk!
 // Consumer should take ownership of the resulting buffer.
+/*
+ * Entries are LZ4-compressed and stored (rather than zlib-deflated by the
+ * zip writer): decompression is what every process pays on startup, and LZ4
+ * inflates several times faster for these entry sizes. Compressed entries
+ * are framed with a magic and the decompressed size; entries without the
+ * magic (caches written before this change, and omnijar-provided buffers)
+ * are passed through unchanged, so old caches stay readable.
+ */
+static const char kLZ4Magic[4] = { 'L', 'Z', '4', '\0' };
+static const size_t kLZ4HeaderSize = sizeof(kLZ4Magic) + sizeof(uint32_t);
+
+static nsresult
+MaybeDecompressLZ4Entry(UniquePtr<char[]>* ioBuf, uint32_t* ioLength)
+{
+  if (*ioLength < kLZ4HeaderSize ||
+      memcmp(ioBuf->get(), kLZ4Magic, sizeof(kLZ4Magic)) != 0) {
+    // A legacy (deflated-by-zip) or omnijar entry; already raw.
+    return NS_OK;
+  }
+
+  uint32_t decompressedSize;
+  memcpy(&decompressedSize, ioBuf->get() + sizeof(kLZ4Magic), sizeof(uint32_t));
+  UniquePtr<char[]> decompressed(new char[decompressedSize]);
+  if (!Compression::LZ4::decompress(ioBuf->get() + kLZ4HeaderSize,
+                                    decompressed.get(), decompressedSize)) {
+    return NS_ERROR_FAILURE;
+  }
+  *ioBuf = mozilla::Move(decompressed);
+  *ioLength = decompressedSize;
+  return NS_OK;
+}
+
 nsresult
 StartupCache::GetBuffer(const char* id, UniquePtr<char[]>* outbuf, uint32_t* length)
 {
@@ -287,6 +320,9 @@ StartupCache::GetBuffer(const char* id, UniquePtr<char[]>* outbuf, uint32_t* len
   }
 
   nsresult rv = GetBufferFromZipArchive(mArchive, true, id, outbuf, length);
+  if (NS_SUCCEEDED(rv)) {
+    rv = MaybeDecompressLZ4Entry(outbuf, length);
+  }
   if (NS_SUCCEEDED(rv))
     return rv;
 
@@ -378,7 +414,21 @@ CacheCloseHelper(const nsACString& key, const CacheEntry* data,
   nsIStringInputStream* stream = holder->stream;
   nsIZipWriter* writer = holder->writer;
 
-  stream->ShareData(data->data.get(), data->size);
+  nsAutoCString compressed;
+  size_t maxSize = Compression::LZ4::maxCompressedSize(data->size);
+  if (compressed.SetLength(kLZ4HeaderSize + maxSize, fallible)) {
+    char* buf = compressed.BeginWriting();
+    memcpy(buf, kLZ4Magic, sizeof(kLZ4Magic));
+    uint32_t decompressedSize = data->size;
+    memcpy(buf + sizeof(kLZ4Magic), &decompressedSize, sizeof(uint32_t));
+    size_t compressedSize = Compression::LZ4::compress(
+      data->data.get(), data->size, buf + kLZ4HeaderSize);
+    compressed.SetLength(kLZ4HeaderSize + compressedSize);
+    stream->ShareData(compressed.get(), compressed.Length());
+  } else {
+    // OOM on the compression buffer; store the raw bytes.
+    stream->ShareData(data->data.get(), data->size);
+  }
 
 #ifdef DEBUG
   bool hasEntry;
@@ -386,7 +436,7 @@ CacheCloseHelper(const nsACString& key, const CacheEntry* data,
   NS_ASSERTION(NS_SUCCEEDED(rv) && hasEntry == false,
                "Existing entry in disk StartupCache.");
 #endif
-  rv = writer->AddEntryStream(key, holder->time, true, stream, false);
+  rv = writer->AddEntryStream(key, holder->time, false, stream, false);
 
   if (NS_FAILED(rv)) {
     NS_WARNING("cache entry deleted but not written to disk.");
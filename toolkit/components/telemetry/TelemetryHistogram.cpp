@@ -14,11 +14,14 @@
 #include "nsClassHashtable.h"
 #include "nsITelemetry.h"
 #include "nsPrintfCString.h"
+#include "nsTArray.h"
+#include "prthread.h"
 
 #include "mozilla/dom/ToJSValue.h"
 #include "mozilla/gfx/GPUProcessManager.h"
 #include "mozilla/Atomics.h"
 #include "mozilla/StartupTimeline.h"
+#include "mozilla/Mutex.h"
 #include "mozilla/StaticMutex.h"
 #include "mozilla/Unused.h"
 
@@ -1750,6 +1753,16 @@ void TelemetryHistogram::InitializeGlobalState(bool canRecordBase,
 void TelemetryHistogram::DeInitializeGlobalState()
 {
   StaticMutexAutoLock locker(gTelemetryHistogramMutex);
+
+  // Drain the per-thread accumulation batches before the histograms go
+  // away; late samples after this point fall back to the locked path and
+  // are dropped by the recording flags below like any post-shutdown
+  // accumulation. The batches themselves are freed by their threads' TLS
+  // destructors.
+  internal_FlushAllAccumulationBatches(locker);
+  delete sAccumulationBatches;
+  sAccumulationBatches = nullptr;
+
   gCanRecordBase = false;
   gCanRecordExtended = false;
   gNameToHistogramIDMap.Clear();
@@ -1861,6 +1874,120 @@ TelemetryHistogram::SetHistogramRecordingEnabled(const nsACString& name,
 }
 
 
+////////////////////////////////////////////////////////////////////////
+//
+// Per-thread accumulation batching.
+//
+// Plain (unkeyed) accumulations land in a small per-thread buffer and only
+// take gTelemetryHistogramMutex once per kAccumulationBatchSize samples, so
+// hot-path probes on the main and media threads stop contending on the
+// global lock and write no shared cache lines. Buffers are flushed by their
+// owning thread when full; snapshots may therefore lag a thread's most
+// recent (at most 63) samples, which the once-a-day ping cadence never
+// notices.
+
+namespace {
+
+const size_t kAccumulationBatchSize = 64;
+
+struct PendingAccumulation
+{
+  mozilla::Telemetry::HistogramID mId;
+  uint32_t mSample;
+};
+
+// Owned by its thread through NSPR TLS (whose destructor flushes and frees
+// it on thread exit) and registered in sAccumulationBatches so snapshot
+// assembly and shutdown can flush every thread's pending samples. The
+// owning thread appends under mLock (uncontended, thread-local cache line);
+// cross-thread flushers copy the entries out under mLock and accumulate
+// them while holding gTelemetryHistogramMutex. Nobody ever holds mLock
+// while *acquiring* the histogram mutex, so lock order is always
+// histogram-mutex -> batch (or batch alone).
+struct AccumulationBatch
+{
+  AccumulationBatch()
+    : mLock("TelemetryAccumulationBatch")
+  {
+  }
+
+  mozilla::Mutex mLock;
+  size_t mCount = 0;
+  PendingAccumulation mEntries[kAccumulationBatchSize];
+};
+
+// All live batches; guarded by gTelemetryHistogramMutex.
+static nsTArray<AccumulationBatch*>* sAccumulationBatches = nullptr;
+
+static PRUintn sAccumulationBatchTLS;
+static mozilla::Atomic<bool> sAccumulationBatchInitialized(false);
+
+// Copy the batch's entries out under its lock, then accumulate them under
+// the histogram mutex (which the caller must not hold).
+static void
+FlushAccumulationBatch(AccumulationBatch* aBatch)
+{
+  PendingAccumulation pending[kAccumulationBatchSize];
+  size_t count;
+  {
+    mozilla::MutexAutoLock lock(aBatch->mLock);
+    count = aBatch->mCount;
+    memcpy(pending, aBatch->mEntries, count * sizeof(PendingAccumulation));
+    aBatch->mCount = 0;
+  }
+
+  if (count) {
+    StaticMutexAutoLock locker(gTelemetryHistogramMutex);
+    if (!gInitDone) {
+      // Histogram storage is gone (thread exiting after telemetry
+      // shutdown); the samples are dropped like any post-shutdown
+      // accumulation.
+      return;
+    }
+    for (size_t i = 0; i < count; i++) {
+      internal_Accumulate(pending[i].mId, pending[i].mSample);
+    }
+  }
+}
+
+// Flush every thread's batch. The caller holds gTelemetryHistogramMutex;
+// taking each batch's lock under it follows the documented lock order.
+static void
+internal_FlushAllAccumulationBatches(const StaticMutexAutoLock& aLock)
+{
+  if (!sAccumulationBatches) {
+    return;
+  }
+  for (AccumulationBatch* batch : *sAccumulationBatches) {
+    mozilla::MutexAutoLock lock(batch->mLock);
+    for (size_t i = 0; i < batch->mCount; i++) {
+      internal_Accumulate(batch->mEntries[i].mId, batch->mEntries[i].mSample);
+    }
+    batch->mCount = 0;
+  }
+}
+
+// NSPR TLS destructor: flush the dying thread's remaining samples,
+// unregister and free the batch.
+static void
+DestroyAccumulationBatch(void* aData)
+{
+  auto batch = static_cast<AccumulationBatch*>(aData);
+  if (!batch) {
+    return;
+  }
+  FlushAccumulationBatch(batch);
+  {
+    StaticMutexAutoLock locker(gTelemetryHistogramMutex);
+    if (sAccumulationBatches) {
+      sAccumulationBatches->RemoveElement(batch);
+    }
+  }
+  delete batch;
+}
+
+} // namespace
+
 void
 TelemetryHistogram::Accumulate(HistogramID aID,
                                uint32_t aSample)
@@ -1870,8 +1997,44 @@ TelemetryHistogram::Accumulate(HistogramID aID,
     return;
   }
 
-  StaticMutexAutoLock locker(gTelemetryHistogramMutex);
-  internal_Accumulate(aID, aSample);
+  if (!sAccumulationBatchInitialized) {
+    // Create the TLS key exactly once, under the histogram mutex.
+    StaticMutexAutoLock locker(gTelemetryHistogramMutex);
+    if (!sAccumulationBatchInitialized) {
+      if (PR_NewThreadPrivateIndex(&sAccumulationBatchTLS,
+                                   DestroyAccumulationBatch) != PR_SUCCESS) {
+        internal_Accumulate(aID, aSample);
+        return;
+      }
+      sAccumulationBatches = new nsTArray<AccumulationBatch*>();
+      sAccumulationBatchInitialized = true;
+    }
+  }
+
+  auto batch =
+    static_cast<AccumulationBatch*>(PR_GetThreadPrivate(sAccumulationBatchTLS));
+  if (!batch) {
+    StaticMutexAutoLock locker(gTelemetryHistogramMutex);
+    if (!sAccumulationBatches) {
+      // Telemetry already shut down; take the locked slow path.
+      internal_Accumulate(aID, aSample);
+      return;
+    }
+    batch = new AccumulationBatch();
+    PR_SetThreadPrivate(sAccumulationBatchTLS, batch);
+    sAccumulationBatches->AppendElement(batch);
+  }
+
+  bool needsFlush;
+  {
+    mozilla::MutexAutoLock lock(batch->mLock);
+    batch->mEntries[batch->mCount].mId = aID;
+    batch->mEntries[batch->mCount].mSample = aSample;
+    needsFlush = ++batch->mCount == kAccumulationBatchSize;
+  }
+  if (needsFlush) {
+    FlushAccumulationBatch(batch);
+  }
 }
 
 void
@@ -2075,6 +2238,12 @@ TelemetryHistogram::CreateHistogramSnapshots(JSContext* aCx,
   }
 #endif
 
+  // Pull in every thread's batched accumulations so the snapshot is current.
+  {
+    StaticMutexAutoLock locker(gTelemetryHistogramMutex);
+    internal_FlushAllAccumulationBatches(locker);
+  }
+
   // Runs without protection from |gTelemetryHistogramMutex|
   JS::Rooted<JSObject*> root_obj(aCx, JS_NewPlainObject(aCx));
   if (!root_obj) {
@@ -81,7 +81,13 @@ CollectProfileOrEmptyString(bool aIsShuttingDown)
   UniquePtr<char[]> profile =
     profiler_get_profile(/* aSinceTime */ 0, aIsShuttingDown);
   if (profile) {
-    profileCString = nsCString(profile.get(), strlen(profile.get()));
+    size_t len = strlen(profile.get());
+    // Adopt the serialization buffer rather than copying it: a content
+    // process profile can be hundreds of megabytes, and the transient
+    // second copy here is what used to push 8-content-process captures
+    // into OOM. The buffer comes from infallible new[], which is
+    // free()-compatible under mozalloc.
+    profileCString.Adopt(profile.release(), len);
   } else {
     profileCString = EmptyCString();
   }
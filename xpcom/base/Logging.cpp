@@ -4,6 +4,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include "mozilla/IntegerPrintfMacros.h"
+#include "mozilla/UniquePtr.h"
 #include "mozilla/Logging.h"
 
 #include <algorithm>
@@ -163,6 +165,103 @@ namespace {
   }
 }
 
+namespace detail {
+
+/**
+ * A bounded multi-producer single-consumer ring of preformatted log records
+ * backing the "async" MOZ_LOG option. A producer claims a slot with a single
+ * compare-exchange, fills it, and publishes it through the slot's sequence
+ * number; the drainer thread consumes slots in order and performs all file
+ * I/O. When the ring is full the record is dropped and counted - the hot
+ * path never takes a lock, touches a FILE, or blocks.
+ */
+class AsyncLogRing
+{
+public:
+  static const size_t kSlotCount = 4096;  // Must be a power of two.
+  static const size_t kTextSize = 448;
+  static const size_t kThreadNameSize = 40;
+
+  struct Record
+  {
+    PRTime mTimestamp;
+    const char* mModuleName;  // Static module name string.
+    LogLevel mLevel;
+    char mThreadName[kThreadNameSize];
+    char mText[kTextSize];
+  };
+
+  AsyncLogRing()
+    : mHead(0)
+    , mTail(0)
+    , mDropped(0)
+  {
+    for (size_t i = 0; i < kSlotCount; i++) {
+      mSlots[i].mSequence = i;
+    }
+  }
+
+  bool Enqueue(PRTime aTimestamp, const char* aModuleName, LogLevel aLevel,
+               const char* aThreadName, const char* aText)
+  {
+    size_t pos = mHead;
+    for (;;) {
+      Slot& slot = mSlots[pos & (kSlotCount - 1)];
+      size_t seq = slot.mSequence;
+      if (seq == pos) {
+        if (mHead.compareExchange(pos, pos + 1)) {
+          Record& record = slot.mRecord;
+          record.mTimestamp = aTimestamp;
+          record.mModuleName = aModuleName;
+          record.mLevel = aLevel;
+          strncpy(record.mThreadName, aThreadName, kThreadNameSize - 1);
+          record.mThreadName[kThreadNameSize - 1] = '\0';
+          strncpy(record.mText, aText, kTextSize - 1);
+          record.mText[kTextSize - 1] = '\0';
+          slot.mSequence = pos + 1;
+          return true;
+        }
+        pos = mHead;
+      } else if (seq < pos + 1) {
+        // The ring is full; drop rather than stall the caller.
+        mDropped++;
+        return false;
+      } else {
+        pos = mHead;
+      }
+    }
+  }
+
+  // Only the drainer thread may call this.
+  bool Dequeue(Record& aRecord)
+  {
+    Slot& slot = mSlots[mTail & (kSlotCount - 1)];
+    if (slot.mSequence != mTail + 1) {
+      return false;
+    }
+    aRecord = slot.mRecord;
+    slot.mSequence = mTail + kSlotCount;
+    mTail++;
+    return true;
+  }
+
+  uint64_t Dropped() const { return mDropped; }
+
+private:
+  struct Slot
+  {
+    Atomic<size_t> mSequence;
+    Record mRecord;
+  };
+
+  Slot mSlots[kSlotCount];
+  Atomic<size_t> mHead;
+  size_t mTail;
+  Atomic<uint64_t> mDropped;
+};
+
+} // namespace detail
+
 class LogModuleManager
 {
 public:
@@ -179,11 +278,20 @@ public:
     , mAddTimestamp(false)
     , mIsSync(false)
     , mRotate(0)
+    , mIsAsync(false)
+    , mAsyncShutdown(false)
+    , mAsyncThread(nullptr)
   {
   }
 
   ~LogModuleManager()
   {
+    if (mAsyncThread) {
+      mAsyncShutdown = true;
+      PR_JoinThread(mAsyncThread);
+      mAsyncThread = nullptr;
+    }
+
     detail::LogFile* logFile = mOutFile.exchange(nullptr);
     delete logFile;
   }
@@ -196,6 +304,7 @@ public:
     bool shouldAppend = false;
     bool addTimestamp = false;
     bool isSync = false;
+    bool isAsync = false;
     int32_t rotate = 0;
     const char* modules = PR_GetEnv("MOZ_LOG");
     if (!modules || !modules[0]) {
@@ -214,7 +323,7 @@ public:
     }
 
     NSPRLogModulesParser(modules,
-        [&shouldAppend, &addTimestamp, &isSync, &rotate]
+        [&shouldAppend, &addTimestamp, &isSync, &isAsync, &rotate]
             (const char* aName, LogLevel aLevel, int32_t aValue) mutable {
           if (strcmp(aName, "append") == 0) {
             shouldAppend = true;
@@ -222,6 +331,8 @@ public:
             addTimestamp = true;
           } else if (strcmp(aName, "sync") == 0) {
             isSync = true;
+          } else if (strcmp(aName, "async") == 0) {
+            isAsync = true;
           } else if (strcmp(aName, "rotate") == 0) {
             rotate = (aValue << 20) / kRotateFilesNumber;
           } else {
@@ -238,6 +349,23 @@ public:
       NS_WARNING("MOZ_LOG: when you rotate the log, you cannot use append!");
     }
 
+    // Async moves all file I/O to a drainer thread; sync and rotate both
+    // need the writer to observe the file inline, so they win over async.
+    if (isAsync && (isSync || rotate > 0)) {
+      NS_WARNING("MOZ_LOG: async cannot be combined with sync or rotate!");
+      isAsync = false;
+    }
+    if (isAsync) {
+      mAsyncRing = mozilla::MakeUnique<detail::AsyncLogRing>();
+      mAsyncThread = PR_CreateThread(PR_USER_THREAD, AsyncLoggerMain, this,
+                                     PR_PRIORITY_LOW, PR_GLOBAL_THREAD,
+                                     PR_JOINABLE_THREAD, 0);
+      mIsAsync = !!mAsyncThread;
+      // Records are only readable with timestamps since they are written out
+      // later than they happen.
+      mAddTimestamp = mAddTimestamp || mIsAsync;
+    }
+
     const char* logFile = PR_GetEnv("MOZ_LOG_FILE");
     if (!logFile || !logFile[0]) {
       logFile = PR_GetEnv("NSPR_LOG_FILE");
@@ -360,6 +488,74 @@ public:
     return module;
   }
 
+  static void AsyncLoggerMain(void* aArg)
+  {
+    static_cast<LogModuleManager*>(aArg)->AsyncLoggerThread();
+  }
+
+  void AsyncLoggerThread()
+  {
+    PR_SetCurrentThreadName("MOZ_LOG Drainer");
+
+    uint64_t reportedDrops = 0;
+    detail::AsyncLogRing::Record record;
+    for (;;) {
+      bool wrote = false;
+      while (mAsyncRing->Dequeue(record)) {
+        WriteAsyncRecord(record);
+        wrote = true;
+      }
+
+      uint64_t drops = mAsyncRing->Dropped();
+      if (drops != reportedDrops) {
+        detail::AsyncLogRing::Record notice;
+        notice.mTimestamp = PR_Now();
+        notice.mModuleName = "Logger";
+        notice.mLevel = LogLevel::Warning;
+        strcpy(notice.mThreadName, "MOZ_LOG Drainer");
+        SprintfLiteral(notice.mText,
+                       "async log ring overflowed; %" PRIu64
+                       " records dropped so far",
+                       drops);
+        WriteAsyncRecord(notice);
+        reportedDrops = drops;
+      }
+
+      if (!wrote) {
+        if (mAsyncShutdown) {
+          break;
+        }
+        PR_Sleep(PR_MillisecondsToInterval(10));
+      }
+    }
+
+    detail::LogFile* outFile = mOutFile;
+    fflush(outFile ? outFile->File() : stderr);
+  }
+
+  void WriteAsyncRecord(const detail::AsyncLogRing::Record& aRecord)
+  {
+    FILE* out = stderr;
+    detail::LogFile* outFile = mOutFile;
+    if (outFile) {
+      out = outFile->File();
+    }
+
+    size_t textLen = strlen(aRecord.mText);
+    const char* newline =
+      (textLen == 0 || aRecord.mText[textLen - 1] != '\n') ? "\n" : "";
+
+    PRExplodedTime now;
+    PR_ExplodeTime(aRecord.mTimestamp, PR_GMTParameters, &now);
+    fprintf_stderr(
+        out,
+        "%04d-%02d-%02d %02d:%02d:%02d.%06d UTC - [%s]: %s/%s %s%s",
+        now.tm_year, now.tm_month + 1, now.tm_mday,
+        now.tm_hour, now.tm_min, now.tm_sec, now.tm_usec,
+        aRecord.mThreadName, ToLogStr(aRecord.mLevel),
+        aRecord.mModuleName, aRecord.mText, newline);
+  }
+
   void Print(const char* aName, LogLevel aLevel, const char* aFmt, va_list aArgs)
     MOZ_FORMAT_PRINTF(4, 0)
   {
@@ -395,6 +591,23 @@ public:
       newline = "\n";
     }
 
+    if (mIsAsync) {
+      // Hand the formatted record to the drainer thread; the hot path does
+      // no file I/O and never blocks (full ring drops the record).
+      PRThread* currentThread = PR_GetCurrentThread();
+      const char* currentThreadName = (mMainThread == currentThread)
+        ? "Main Thread"
+        : PR_GetThreadName(currentThread);
+      char noNameThread[40];
+      if (!currentThreadName) {
+        SprintfLiteral(noNameThread, "Unnamed thread %p", currentThread);
+        currentThreadName = noNameThread;
+      }
+      mAsyncRing->Enqueue(PR_Now(), aName, aLevel, currentThreadName,
+                          buffToWrite);
+      return;
+    }
+
     FILE* out = stderr;
 
     // In case we use rotate, this ensures the FILE is kept alive during
@@ -511,6 +724,10 @@ private:
   Atomic<bool, Relaxed> mAddTimestamp;
   Atomic<bool, Relaxed> mIsSync;
   int32_t mRotate;
+  bool mIsAsync;
+  Atomic<bool, Relaxed> mAsyncShutdown;
+  PRThread* mAsyncThread;
+  UniquePtr<detail::AsyncLogRing> mAsyncRing;
 };
 
 StaticAutoPtr<LogModuleManager> sLogModuleManager;
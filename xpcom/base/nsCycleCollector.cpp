@@ -2923,6 +2923,7 @@ nsCycleCollector::MarkRoots(SliceBudget& aBudget)
 {
   JS::AutoAssertNoGC nogc;
   TimeLog timeLog;
+  mozilla::AutoProfilerTracing tracing("CC", "BuildGraph");
   AutoRestore<bool> ar(mScanInProgress);
   MOZ_RELEASE_ASSERT(!mScanInProgress);
   mScanInProgress = true;
@@ -3243,6 +3244,8 @@ nsCycleCollector::ScanBlackNodes()
 void
 nsCycleCollector::ScanRoots(bool aFullySynchGraphBuild)
 {
+  mozilla::AutoProfilerTracing tracing("CC", "ScanRoots");
+
   JS::AutoAssertNoGC nogc;
   AutoRestore<bool> ar(mScanInProgress);
   MOZ_RELEASE_ASSERT(!mScanInProgress);
@@ -3307,6 +3310,8 @@ nsCycleCollector::ScanRoots(bool aFullySynchGraphBuild)
 bool
 nsCycleCollector::CollectWhite()
 {
+  mozilla::AutoProfilerTracing tracing("CC", "CollectWhite");
+
   // Explanation of "somewhat modified": we have no way to collect the
   // set of whites "all at once", we have to ask each of them to drop
   // their outgoing links and assume this will cause the garbage cycle
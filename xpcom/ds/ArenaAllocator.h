@@ -43,6 +43,8 @@ public:
   constexpr ArenaAllocator()
     : mHead()
     , mCurrent(nullptr)
+    , mRecycled(nullptr)
+    , mRecycledCount(0)
   {
      static_assert(mozilla::tl::FloorLog2<Alignment>::value ==
                    mozilla::tl::CeilingLog2<Alignment>::value,
@@ -59,6 +61,7 @@ public:
   ~ArenaAllocator()
   {
     Clear();
+    ClearRecycledChunks();
   }
 
   /**
@@ -103,6 +106,70 @@ public:
     mCurrent = nullptr;
   }
 
+  /**
+   * Move chunks out of aOther (leaving it empty and reusable) into this
+   * allocator's recycled-chunk supply, resetting each chunk to empty.
+   * Recycled chunks are handed out by AllocateChunk before malloc is
+   * consulted, so a fresh arena adopting a retired one's chunks starts with
+   * warm, already-faulted pages. Only standard-size chunks are kept, at most
+   * aMaxRecycled in total across the supply, so retiring one enormous
+   * consumer cannot pin its whole footprint; excess and oversized chunks are
+   * freed.
+   */
+  void RecycleChunksFrom(ArenaAllocator& aOther, size_t aMaxRecycled)
+  {
+    auto a = aOther.mHead.next;
+    while (a) {
+      auto tmp = a;
+      a = a->next;
+      if (mRecycledCount < aMaxRecycled &&
+          uintptr_t(tmp) + ArenaSize == tmp->header.tail) {
+        // Reset to empty and push on the recycled list.
+        tmp->header.offset = AlignedSize(uintptr_t(tmp + 1));
+        MOZ_MAKE_MEM_NOACCESS((void*)tmp->header.offset,
+                              tmp->header.tail - tmp->header.offset);
+        tmp->next = mRecycled;
+        mRecycled = tmp;
+        mRecycledCount++;
+      } else {
+        free(tmp);
+      }
+    }
+    aOther.mHead.next = nullptr;
+    aOther.mCurrent = nullptr;
+  }
+
+  /**
+   * Move aOther's recycled-chunk supply into ours (used to adopt chunks from
+   * a shared recycling pool).
+   */
+  void TakeRecycledChunksFrom(ArenaAllocator& aOther)
+  {
+    ArenaChunk** tail = &mRecycled;
+    while (*tail) {
+      tail = &(*tail)->next;
+    }
+    *tail = aOther.mRecycled;
+    mRecycledCount += aOther.mRecycledCount;
+    aOther.mRecycled = nullptr;
+    aOther.mRecycledCount = 0;
+  }
+
+  /**
+   * Frees any chunks held in the recycled supply; see RecycleChunksFrom.
+   */
+  void ClearRecycledChunks()
+  {
+    auto a = mRecycled;
+    while (a) {
+      auto tmp = a;
+      a = a->next;
+      free(tmp);
+    }
+    mRecycled = nullptr;
+    mRecycledCount = 0;
+  }
+
   /**
    * Adjusts the given size to the required alignment.
    */
@@ -176,9 +243,20 @@ private:
     MOZ_ASSERT(kOffset < aSize);
 
     const size_t chunkSize = aSize + kOffset;
-    void* p = malloc(chunkSize);
-    if (!p) {
-      return nullptr;
+
+    // Prefer a recycled chunk when one is big enough; recycled chunks are
+    // always standard-size, so only standard requests match.
+    void* p = nullptr;
+    if (mRecycled && chunkSize <= ArenaSize) {
+      ArenaChunk* reuse = mRecycled;
+      mRecycled = reuse->next;
+      mRecycledCount--;
+      p = reuse;
+    } else {
+      p = malloc(chunkSize);
+      if (!p) {
+        return nullptr;
+      }
     }
 
     ArenaChunk* arena = new (KnownNotNull, p) ArenaChunk(chunkSize);
@@ -217,6 +295,8 @@ private:
 
   ArenaChunk mHead;
   ArenaChunk* mCurrent;
+  ArenaChunk* mRecycled;
+  size_t mRecycledCount;
 };
 
 } // namespace mozilla
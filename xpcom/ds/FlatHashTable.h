@@ -0,0 +1,387 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef FlatHashTable_h
+#define FlatHashTable_h
+
+/*
+ * A flat, open-addressing hash table with group probing, in the style of
+ * SwissTable. Entry metadata lives in a separate byte array: one control byte
+ * per slot holding either an empty/tombstone marker or the low 7 bits of the
+ * entry's hash. A probe examines a group of 16 control bytes at once (with
+ * SSE2 where available), so the common miss touches one metadata cache line
+ * instead of one entry-store cache line per probe as in PLDHashTable.
+ *
+ * This is intended as an incremental replacement for PLDHashTable's hottest
+ * users: the entry API mirrors PLDHashTable's ops model (hash and match
+ * functions over opaque keys) so nsTHashtable-style adapters can migrate
+ * consumers one at a time.
+ */
+
+#include "mozilla/Assertions.h"
+#include "mozilla/Attributes.h"
+#include "mozilla/HashFunctions.h"
+#include "mozilla/MathAlgorithms.h"
+#include "mozilla/MemoryReporting.h"
+#include "nscore.h"
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MOZ_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace mozilla {
+
+namespace detail {
+
+// Control byte values. Full slots hold 0b0xxxxxxx (the hash's low 7 bits);
+// the markers have the high bit set so a group match never hits them.
+static const uint8_t kFlatHashEmpty = 0x80;
+static const uint8_t kFlatHashTombstone = 0xFE;
+
+class FlatHashGroup
+{
+public:
+  static const size_t kWidth = 16;
+
+#ifdef MOZ_FLAT_HASH_SSE2
+  explicit FlatHashGroup(const uint8_t* aCtrl)
+    : mCtrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(aCtrl)))
+  {
+  }
+
+  // Bitmask of slots in this group whose control byte equals aH2.
+  uint32_t Match(uint8_t aH2) const
+  {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(mCtrl, _mm_set1_epi8(aH2)));
+  }
+
+  uint32_t MatchEmpty() const { return Match(kFlatHashEmpty); }
+
+  // Bitmask of empty or tombstone slots (high bit set, except 0xFF sentinel
+  // never stored).
+  uint32_t MatchAvailable() const { return _mm_movemask_epi8(mCtrl); }
+
+private:
+  __m128i mCtrl;
+#else
+  explicit FlatHashGroup(const uint8_t* aCtrl) { memcpy(mCtrl, aCtrl, kWidth); }
+
+  uint32_t Match(uint8_t aH2) const
+  {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kWidth; i++) {
+      if (mCtrl[i] == aH2) {
+        mask |= 1u << i;
+      }
+    }
+    return mask;
+  }
+
+  uint32_t MatchEmpty() const { return Match(kFlatHashEmpty); }
+
+  uint32_t MatchAvailable() const
+  {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kWidth; i++) {
+      if (mCtrl[i] & 0x80) {
+        mask |= 1u << i;
+      }
+    }
+    return mask;
+  }
+
+private:
+  uint8_t mCtrl[kWidth];
+#endif
+};
+
+} // namespace detail
+
+/*
+ * EntryType requirements:
+ *   - trivially movable by memcpy once constructed in place;
+ *   - a KeyType typedef;
+ *   - static PLDHashNumber-compatible "uint32_t HashKey(KeyType)";
+ *   - "bool KeyEquals(KeyType) const" and "KeyType GetKey() const";
+ *   - constructible from KeyType.
+ */
+template<typename EntryType>
+class FlatHashTable
+{
+  typedef typename EntryType::KeyType KeyType;
+  typedef detail::FlatHashGroup Group;
+
+public:
+  FlatHashTable()
+    : mCtrl(nullptr)
+    , mEntries(nullptr)
+    , mCapacity(0)
+    , mEntryCount(0)
+    , mRemovedCount(0)
+  {
+  }
+
+  ~FlatHashTable() { Clear(); }
+
+  FlatHashTable(const FlatHashTable&) = delete;
+  FlatHashTable& operator=(const FlatHashTable&) = delete;
+
+  uint32_t Count() const { return mEntryCount; }
+  uint32_t Capacity() const { return mCapacity; }
+
+  EntryType* Search(KeyType aKey) const
+  {
+    if (!mCtrl) {
+      return nullptr;
+    }
+
+    uint32_t hash = ScrambleHash(EntryType::HashKey(aKey));
+    uint8_t h2 = H2(hash);
+    uint32_t index = H1(hash) & (mCapacity - 1);
+
+    for (uint32_t probes = 0; probes <= mCapacity; probes += Group::kWidth) {
+      Group group(mCtrl + index);
+      for (uint32_t match = group.Match(h2); match; match &= match - 1) {
+        uint32_t slot =
+          (index + CountTrailingZeroes32(match)) & (mCapacity - 1);
+        EntryType* entry = &mEntries[slot];
+        if (MOZ_LIKELY(entry->KeyEquals(aKey))) {
+          return entry;
+        }
+      }
+      if (group.MatchEmpty()) {
+        return nullptr;
+      }
+      index = (index + Group::kWidth) & (mCapacity - 1);
+    }
+    return nullptr;
+  }
+
+  // Find or add an entry for aKey. Returns null only on allocation failure.
+  EntryType* Add(KeyType aKey, const fallible_t&)
+  {
+    if (EntryType* existing = Search(aKey)) {
+      return existing;
+    }
+
+    if (!mCtrl || (mEntryCount + mRemovedCount) * 8 >= mCapacity * 7) {
+      // Only grow when live entries justify it; when the pressure is mostly
+      // tombstones, rehash at the same capacity to reclaim them instead of
+      // doubling forever under add/remove churn.
+      uint32_t newCapacity;
+      if (!mCtrl) {
+        newCapacity = kMinCapacity;
+      } else if (mEntryCount * 4 >= mCapacity * 3) {
+        newCapacity = mCapacity * 2;
+      } else {
+        newCapacity = mCapacity;
+      }
+      if (!ChangeCapacity(newCapacity)) {
+        return nullptr;
+      }
+    }
+
+    uint32_t hash = ScrambleHash(EntryType::HashKey(aKey));
+    uint32_t slot = FindInsertSlot(hash);
+    if (mCtrl[slot] == detail::kFlatHashTombstone) {
+      mRemovedCount--;
+    }
+    SetCtrl(slot, H2(hash));
+    new (&mEntries[slot]) EntryType(aKey);
+    mEntryCount++;
+    return &mEntries[slot];
+  }
+
+  EntryType* Add(KeyType aKey)
+  {
+    EntryType* entry = Add(aKey, fallible_t());
+    if (!entry) {
+      MOZ_CRASH("FlatHashTable::Add: out of memory");
+    }
+    return entry;
+  }
+
+  void Remove(KeyType aKey)
+  {
+    EntryType* entry = Search(aKey);
+    if (entry) {
+      RemoveEntry(entry);
+    }
+  }
+
+  void RemoveEntry(EntryType* aEntry)
+  {
+    uint32_t slot = uint32_t(aEntry - mEntries);
+    MOZ_ASSERT(slot < mCapacity && !(mCtrl[slot] & 0x80));
+
+    aEntry->~EntryType();
+    // Probe chains for other keys may pass through this slot, so it must
+    // become a tombstone, not an empty; tombstones are reclaimed wholesale on
+    // the next rehash.
+    SetCtrl(slot, detail::kFlatHashTombstone);
+    mRemovedCount++;
+    mEntryCount--;
+  }
+
+  void Clear()
+  {
+    if (!mCtrl) {
+      return;
+    }
+    for (uint32_t i = 0; i < mCapacity; i++) {
+      if (!(mCtrl[i] & 0x80)) {
+        mEntries[i].~EntryType();
+      }
+    }
+    free(mCtrl);
+    free(mEntries);
+    mCtrl = nullptr;
+    mEntries = nullptr;
+    mCapacity = 0;
+    mEntryCount = 0;
+    mRemovedCount = 0;
+  }
+
+  // Simple forward iteration over live entries.
+  class Iterator
+  {
+  public:
+    explicit Iterator(const FlatHashTable* aTable)
+      : mTable(aTable)
+      , mIndex(0)
+    {
+      Settle();
+    }
+
+    bool Done() const { return mIndex >= mTable->mCapacity; }
+
+    EntryType* Get() const
+    {
+      MOZ_ASSERT(!Done());
+      return &mTable->mEntries[mIndex];
+    }
+
+    void Next()
+    {
+      mIndex++;
+      Settle();
+    }
+
+  private:
+    void Settle()
+    {
+      while (mIndex < mTable->mCapacity && (mTable->mCtrl[mIndex] & 0x80)) {
+        mIndex++;
+      }
+    }
+
+    const FlatHashTable* mTable;
+    uint32_t mIndex;
+  };
+
+  Iterator Iter() const { return Iterator(this); }
+
+  size_t ShallowSizeOfExcludingThis(MallocSizeOf aMallocSizeOf) const
+  {
+    size_t n = 0;
+    if (mCtrl) {
+      n += aMallocSizeOf(mCtrl);
+      n += aMallocSizeOf(mEntries);
+    }
+    return n;
+  }
+
+private:
+  struct fallible_t
+  {
+  };
+
+  static const uint32_t kMinCapacity = 16;
+
+  // Multiply by the golden ratio to spread key entropy into the bits H1
+  // consumes, as PLDHashTable does before taking its modulus.
+  static uint32_t ScrambleHash(uint32_t aHash) { return aHash * 0x9E3779B9u; }
+
+  static uint32_t H1(uint32_t aHash) { return aHash >> 7; }
+  static uint8_t H2(uint32_t aHash) { return aHash & 0x7F; }
+
+  void SetCtrl(uint32_t aSlot, uint8_t aValue)
+  {
+    mCtrl[aSlot] = aValue;
+    // The control array is mirrored past the end by one group so unaligned
+    // group loads near the wrap-around read valid bytes.
+    if (aSlot < Group::kWidth) {
+      mCtrl[mCapacity + aSlot] = aValue;
+    }
+  }
+
+  uint32_t FindInsertSlot(uint32_t aHash) const
+  {
+    uint32_t index = H1(aHash) & (mCapacity - 1);
+    for (;;) {
+      Group group(mCtrl + index);
+      uint32_t avail = group.MatchAvailable();
+      if (avail) {
+        return (index + CountTrailingZeroes32(avail)) & (mCapacity - 1);
+      }
+      index = (index + Group::kWidth) & (mCapacity - 1);
+    }
+  }
+
+  bool ChangeCapacity(uint32_t aNewCapacity)
+  {
+    MOZ_ASSERT(IsPowerOfTwo(aNewCapacity));
+
+    uint8_t* oldCtrl = mCtrl;
+    EntryType* oldEntries = mEntries;
+    uint32_t oldCapacity = mCapacity;
+
+    uint8_t* newCtrl =
+      static_cast<uint8_t*>(malloc(aNewCapacity + Group::kWidth));
+    EntryType* newEntries =
+      static_cast<EntryType*>(malloc(size_t(aNewCapacity) * sizeof(EntryType)));
+    if (!newCtrl || !newEntries) {
+      free(newCtrl);
+      free(newEntries);
+      return false;
+    }
+    memset(newCtrl, detail::kFlatHashEmpty, aNewCapacity + Group::kWidth);
+
+    mCtrl = newCtrl;
+    mEntries = newEntries;
+    mCapacity = aNewCapacity;
+    mRemovedCount = 0;
+
+    for (uint32_t i = 0; i < oldCapacity; i++) {
+      if (oldCtrl[i] & 0x80) {
+        continue;
+      }
+      EntryType* oldEntry = &oldEntries[i];
+      uint32_t hash = ScrambleHash(EntryType::HashKey(oldEntry->GetKey()));
+      uint32_t slot = FindInsertSlot(hash);
+      SetCtrl(slot, H2(hash));
+      memcpy(static_cast<void*>(&mEntries[slot]),
+             static_cast<const void*>(oldEntry), sizeof(EntryType));
+    }
+
+    free(oldCtrl);
+    free(oldEntries);
+    return true;
+  }
+
+  uint8_t* mCtrl;        // mCapacity + kWidth bytes, mirrored head.
+  EntryType* mEntries;
+  uint32_t mCapacity;    // Always a power of two (or zero).
+  uint32_t mEntryCount;
+  uint32_t mRemovedCount;
+};
+
+} // namespace mozilla
+
+#endif // FlatHashTable_h
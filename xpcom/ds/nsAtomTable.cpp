@@ -8,12 +8,15 @@
 #include "mozilla/Attributes.h"
 #include "mozilla/HashFunctions.h"
 #include "mozilla/MemoryReporting.h"
+#include "mozilla/PodOperations.h"
 #include "mozilla/Mutex.h"
 #include "mozilla/DebugOnly.h"
 #include "mozilla/Sprintf.h"
 #include "mozilla/Unused.h"
 
 #include "nsAtomTable.h"
+
+#include "prthread.h"
 #include "nsStaticAtom.h"
 #include "nsString.h"
 #include "nsCRT.h"
@@ -40,8 +43,8 @@
 //   atoms ignore all AddRef/Release calls, which ensures they stay alive until
 //   |gAtomTable| itself is destroyed whereupon they are explicitly deleted.
 //
-// Note that gAtomTable is used on multiple threads, and callers must acquire
-// gAtomTableLock before touching it.
+// Note that the atom table shards are used on multiple threads, and callers
+// must acquire the relevant shard's lock before touching it.
 
 using namespace mozilla;
 
@@ -72,6 +75,8 @@ enum class GCKind {
   Shutdown,
 };
 
+class nsAtomSubTable;
+
 // This class encapsulates the functions that need access to nsAtom's private
 // members.
 class nsAtomFriend
@@ -83,8 +88,9 @@ public:
   static void AtomTableClearEntry(PLDHashTable* aTable,
                                   PLDHashEntryHdr* aEntry);
 
-  static void GCAtomTableLocked(const MutexAutoLock& aProofOfLock,
-                                GCKind aKind);
+  static size_t GCAtomTableLocked(nsAtomSubTable& aTable,
+                                  const MutexAutoLock& aProofOfLock,
+                                  GCKind aKind);
 
   static already_AddRefed<nsIAtom> Atomize(const nsACString& aUTF8String);
   static already_AddRefed<nsIAtom> Atomize(const nsAString& aUTF16String);
@@ -262,12 +268,31 @@ nsIAtom::Release()
 //----------------------------------------------------------------------
 
 /**
- * The shared hash table for atom lookups.
+ * The shared hash table for atom lookups, split into independently locked
+ * shards selected by key hash, so that e.g. Stylo worker threads atomizing in
+ * parallel contend on different locks.
  *
- * Callers must hold gAtomTableLock before manipulating the table.
+ * Callers must hold a shard's mLock before manipulating that shard's mTable.
  */
-static PLDHashTable* gAtomTable;
-static Mutex* gAtomTableLock;
+class nsAtomSubTable
+{
+public:
+  Mutex mLock;
+  PLDHashTable mTable;
+  nsAtomSubTable();
+};
+
+// Must be a power of two so shard selection is a mask.
+#define ATOM_TABLE_NUM_SHARDS 16
+
+static nsAtomSubTable* gAtomTables;
+
+static inline nsAtomSubTable&
+SelectAtomTable(uint32_t aHash)
+{
+  MOZ_ASSERT(gAtomTables);
+  return gAtomTables[aHash & (ATOM_TABLE_NUM_SHARDS - 1)];
+}
 
 struct AtomTableKey
 {
@@ -385,18 +410,43 @@ static const PLDHashTableOps AtomTableOps = {
 static nsAtom*
   sRecentlyUsedMainThreadAtoms[RECENTLY_USED_MAIN_THREAD_ATOM_CACHE_SIZE] = {};
 
-void
-nsAtomFriend::GCAtomTableLocked(const MutexAutoLock& aProofOfLock, GCKind aKind)
+// A per-thread recently-atomized cache for the other threads (Stylo workers
+// chiefly), so the common repeat lookup touches no shared state at all.
+// Unlike the main-thread cache these slots hold strong references: the atom
+// GC runs on the main thread and cannot clear them, so pinning is what keeps
+// a cached atom safe to hand out. The caches are small, and an NSPR TLS
+// destructor releases the pinned refs and frees the cache when its thread
+// exits, so shutdown leak checking sees a clean table.
+struct RecentlyUsedAtomCache
 {
-  MOZ_ASSERT(NS_IsMainThread());
+  nsAtom* mAtoms[RECENTLY_USED_MAIN_THREAD_ATOM_CACHE_SIZE];
+};
+
+static PRUintn sRecentlyUsedOffMainThreadAtomsTLS;
+
+static void
+DestroyRecentlyUsedAtomCache(void* aData)
+{
+  auto cache = static_cast<RecentlyUsedAtomCache*>(aData);
+  if (!cache) {
+    return;
+  }
   for (uint32_t i = 0; i < RECENTLY_USED_MAIN_THREAD_ATOM_CACHE_SIZE; ++i) {
-    sRecentlyUsedMainThreadAtoms[i] = nullptr;
+    NS_IF_RELEASE(cache->mAtoms[i]);
   }
+  delete cache;
+}
 
-  int32_t removedCount = 0; // Use a non-atomic temporary for cheaper increments.
+size_t
+nsAtomFriend::GCAtomTableLocked(nsAtomSubTable& aTable,
+                                const MutexAutoLock& aProofOfLock, GCKind aKind)
+{
+  MOZ_ASSERT(NS_IsMainThread());
+
+  size_t removedCount = 0; // Use a non-atomic temporary for cheaper increments.
   nsAutoCString nonZeroRefcountAtoms;
   uint32_t nonZeroRefcountAtomsCount = 0;
-  for (auto i = gAtomTable->Iter(); !i.Done(); i.Next()) {
+  for (auto i = aTable.mTable.Iter(); !i.Done(); i.Next()) {
     auto entry = static_cast<AtomTableEntry*>(i.Get());
     if (entry->mAtom->IsStaticAtom()) {
       continue;
@@ -434,31 +484,48 @@ nsAtomFriend::GCAtomTableLocked(const MutexAutoLock& aProofOfLock, GCKind aKind)
     NS_ASSERTION(nonZeroRefcountAtomsCount == 0, msg.get());
   }
 
+  return removedCount;
+}
+
+static void
+GCAtomTables(GCKind aKind)
+{
+  MOZ_ASSERT(NS_IsMainThread());
+
+  for (uint32_t i = 0; i < RECENTLY_USED_MAIN_THREAD_ATOM_CACHE_SIZE; ++i) {
+    sRecentlyUsedMainThreadAtoms[i] = nullptr;
+  }
+
+  size_t removedCount = 0;
+  for (uint32_t i = 0; i < ATOM_TABLE_NUM_SHARDS; ++i) {
+    nsAtomSubTable& table = gAtomTables[i];
+    MutexAutoLock lock(table.mLock);
+    removedCount += nsAtomFriend::GCAtomTableLocked(table, lock, aKind);
+  }
+
   // We would like to assert that gUnusedAtomCount matches the number of atoms
   // we found in the table which we removed. During the course of this function,
-  // the atom table is locked, but this lock is not acquired for AddRef() and
-  // Release() calls. This means we might see a gUnusedAtomCount value in
-  // between, say, AddRef() incrementing mRefCnt and it decrementing
+  // each shard is locked in turn, but these locks are not acquired for
+  // AddRef() and Release() calls. This means we might see a gUnusedAtomCount
+  // value in between, say, AddRef() incrementing mRefCnt and it decrementing
   // gUnusedAtomCount. So, we don't bother asserting that there are no unused
-  // atoms at the end of a regular GC. But we can (and do) assert thist just
+  // atoms at the end of a regular GC. But we can (and do) assert this just
   // after the last GC at shutdown.
   //
   // Note that, barring refcounting bugs, an atom can only go from a zero
-  // refcount to a non-zero refcount while the atom table lock is held, so
-  // so we won't try to resurrect a zero refcount atom while trying to delete
-  // it.
+  // refcount to a non-zero refcount while its shard's lock is held, so we
+  // won't try to resurrect a zero refcount atom while trying to delete it.
 
-  MOZ_ASSERT_IF(aKind == GCKind::Shutdown, removedCount == gUnusedAtomCount);
+  MOZ_ASSERT_IF(aKind == GCKind::Shutdown, int32_t(removedCount) == gUnusedAtomCount);
 
-  gUnusedAtomCount -= removedCount;
+  gUnusedAtomCount -= int32_t(removedCount);
 }
 
 static void
 GCAtomTable()
 {
   if (NS_IsMainThread()) {
-    MutexAutoLock lock(*gAtomTableLock);
-    nsAtomFriend::GCAtomTableLocked(lock, GCKind::RegularOperation);
+    GCAtomTables(GCKind::RegularOperation);
   }
 }
 
@@ -555,13 +622,21 @@ static bool gStaticAtomTableSealed = false;
 // shrinking.
 #define ATOM_HASHTABLE_INITIAL_LENGTH  4096
 
+nsAtomSubTable::nsAtomSubTable()
+  : mLock("Atom Sub-Table Lock")
+  , mTable(&AtomTableOps, sizeof(AtomTableEntry),
+           ATOM_HASHTABLE_INITIAL_LENGTH / ATOM_TABLE_NUM_SHARDS)
+{
+}
+
 void
 NS_InitAtomTable()
 {
-  MOZ_ASSERT(!gAtomTable);
-  gAtomTable = new PLDHashTable(&AtomTableOps, sizeof(AtomTableEntry),
-                                ATOM_HASHTABLE_INITIAL_LENGTH);
-  gAtomTableLock = new Mutex("Atom Table Lock");
+  MOZ_ASSERT(!gAtomTables);
+  gAtomTables = new nsAtomSubTable[ATOM_TABLE_NUM_SHARDS];
+  MOZ_ALWAYS_TRUE(PR_NewThreadPrivateIndex(&sRecentlyUsedOffMainThreadAtomsTLS,
+                                           DestroyRecentlyUsedAtomCache) ==
+                  PR_SUCCESS);
 
   // Bug 1340710 has caused us to generate an empty atom at arbitrary times
   // after startup.  If we end up creating one before nsGkAtoms::_empty is
@@ -590,27 +665,26 @@ NS_ShutdownAtomTable()
 #ifdef NS_FREE_PERMANENT_DATA
   // Do a final GC to satisfy leak checking. We skip this step in release
   // builds.
-  {
-    MutexAutoLock lock(*gAtomTableLock);
-    nsAtomFriend::GCAtomTableLocked(lock, GCKind::Shutdown);
-  }
+  GCAtomTables(GCKind::Shutdown);
 #endif
 
-  delete gAtomTable;
-  gAtomTable = nullptr;
-  delete gAtomTableLock;
-  gAtomTableLock = nullptr;
+  delete[] gAtomTables;
+  gAtomTables = nullptr;
 }
 
 void
 NS_SizeOfAtomTablesIncludingThis(MallocSizeOf aMallocSizeOf,
                                  size_t* aMain, size_t* aStatic)
 {
-  MutexAutoLock lock(*gAtomTableLock);
-  *aMain = gAtomTable->ShallowSizeOfIncludingThis(aMallocSizeOf);
-  for (auto iter = gAtomTable->Iter(); !iter.Done(); iter.Next()) {
-    auto entry = static_cast<AtomTableEntry*>(iter.Get());
-    *aMain += entry->mAtom->SizeOfIncludingThis(aMallocSizeOf);
+  *aMain = 0;
+  for (uint32_t i = 0; i < ATOM_TABLE_NUM_SHARDS; ++i) {
+    nsAtomSubTable& table = gAtomTables[i];
+    MutexAutoLock lock(table.mLock);
+    *aMain += table.mTable.ShallowSizeOfIncludingThis(aMallocSizeOf);
+    for (auto iter = table.mTable.Iter(); !iter.Done(); iter.Next()) {
+      auto entry = static_cast<AtomTableEntry*>(iter.Get());
+      *aMain += entry->mAtom->SizeOfIncludingThis(aMallocSizeOf);
+    }
   }
 
   // The atoms pointed to by gStaticAtomTable are also pointed to by gAtomTable,
@@ -621,29 +695,18 @@ NS_SizeOfAtomTablesIncludingThis(MallocSizeOf aMallocSizeOf,
 }
 
 static inline AtomTableEntry*
-GetAtomHashEntry(const char* aString, uint32_t aLength, uint32_t* aHashOut)
+AddAtomEntryLocked(nsAtomSubTable& aTable, const MutexAutoLock& aProofOfLock,
+                   AtomTableKey& aKey)
 {
-  gAtomTableLock->AssertCurrentThreadOwns();
-  AtomTableKey key(aString, aLength, aHashOut);
+  aTable.mLock.AssertCurrentThreadOwns();
   // This is an infallible add.
-  return static_cast<AtomTableEntry*>(gAtomTable->Add(&key));
-}
-
-static inline AtomTableEntry*
-GetAtomHashEntry(const char16_t* aString, uint32_t aLength, uint32_t* aHashOut)
-{
-  gAtomTableLock->AssertCurrentThreadOwns();
-  AtomTableKey key(aString, aLength, aHashOut);
-  // This is an infallible add.
-  return static_cast<AtomTableEntry*>(gAtomTable->Add(&key));
+  return static_cast<AtomTableEntry*>(aTable.mTable.Add(&aKey));
 }
 
 void
 nsAtomFriend::RegisterStaticAtoms(const nsStaticAtom* aAtoms,
                                   uint32_t aAtomCount)
 {
-  MutexAutoLock lock(*gAtomTableLock);
-
   MOZ_RELEASE_ASSERT(!gStaticAtomTableSealed,
                      "Atom table has already been sealed!");
 
@@ -660,9 +723,11 @@ nsAtomFriend::RegisterStaticAtoms(const nsStaticAtom* aAtoms,
     uint32_t stringLen = stringBuffer->StorageSize() / sizeof(char16_t) - 1;
 
     uint32_t hash;
-    AtomTableEntry* he =
-      GetAtomHashEntry(static_cast<char16_t*>(stringBuffer->Data()),
-                       stringLen, &hash);
+    AtomTableKey key(static_cast<char16_t*>(stringBuffer->Data()),
+                     stringLen, &hash);
+    nsAtomSubTable& table = SelectAtomTable(hash);
+    MutexAutoLock lock(table.mLock);
+    AtomTableEntry* he = AddAtomEntryLocked(table, lock, key);
 
     nsAtom* atom = he->mAtom;
     if (atom) {
@@ -706,11 +771,11 @@ NS_Atomize(const char* aUTF8String)
 already_AddRefed<nsIAtom>
 nsAtomFriend::Atomize(const nsACString& aUTF8String)
 {
-  MutexAutoLock lock(*gAtomTableLock);
   uint32_t hash;
-  AtomTableEntry* he = GetAtomHashEntry(aUTF8String.Data(),
-                                        aUTF8String.Length(),
-                                        &hash);
+  AtomTableKey key(aUTF8String.Data(), aUTF8String.Length(), &hash);
+  nsAtomSubTable& table = SelectAtomTable(hash);
+  MutexAutoLock lock(table.mLock);
+  AtomTableEntry* he = AddAtomEntryLocked(table, lock, key);
 
   if (he->mAtom) {
     nsCOMPtr<nsIAtom> atom = he->mAtom;
@@ -746,23 +811,56 @@ NS_Atomize(const char16_t* aUTF16String)
 already_AddRefed<nsIAtom>
 nsAtomFriend::Atomize(const nsAString& aUTF16String)
 {
-  MutexAutoLock lock(*gAtomTableLock);
   uint32_t hash;
-  AtomTableEntry* he = GetAtomHashEntry(aUTF16String.Data(),
-                                        aUTF16String.Length(),
-                                        &hash);
+  AtomTableKey key(aUTF16String.Data(), aUTF16String.Length(), &hash);
 
-  if (he->mAtom) {
-    nsCOMPtr<nsIAtom> atom = he->mAtom;
+  // Off the main thread, consult this thread's recently-atomized cache first;
+  // a hit avoids taking any lock.
+  RecentlyUsedAtomCache* cache = nullptr;
+  uint32_t cacheIndex = 0;
+  if (!NS_IsMainThread()) {
+    cache = static_cast<RecentlyUsedAtomCache*>(
+      PR_GetThreadPrivate(sRecentlyUsedOffMainThreadAtomsTLS));
+    if (!cache) {
+      cache = new RecentlyUsedAtomCache();
+      PodZero(cache);
+      PR_SetThreadPrivate(sRecentlyUsedOffMainThreadAtomsTLS, cache);
+    }
+    cacheIndex = hash % RECENTLY_USED_MAIN_THREAD_ATOM_CACHE_SIZE;
+    nsAtom* cached = cache->mAtoms[cacheIndex];
+    if (cached && cached->GetLength() == key.mLength &&
+        memcmp(cached->GetUTF16String(), key.mUTF16String,
+               key.mLength * sizeof(char16_t)) == 0) {
+      nsCOMPtr<nsIAtom> atom = cached;
+      return atom.forget();
+    }
+  }
 
-    return atom.forget();
+  nsAtomSubTable& table = SelectAtomTable(hash);
+  nsAtom* result;
+  nsCOMPtr<nsIAtom> retVal;
+  {
+    MutexAutoLock lock(table.mLock);
+    AtomTableEntry* he = AddAtomEntryLocked(table, lock, key);
+
+    if (he->mAtom) {
+      retVal = he->mAtom;
+    } else {
+      RefPtr<nsAtom> atom = dont_AddRef(
+        new nsAtom(nsAtom::AtomKind::DynamicAtom, aUTF16String, hash));
+      he->mAtom = atom;
+      retVal = atom.forget();
+    }
+    result = he->mAtom;
   }
 
-  RefPtr<nsAtom> atom =
-    dont_AddRef(new nsAtom(nsAtom::AtomKind::DynamicAtom, aUTF16String, hash));
-  he->mAtom = atom;
+  if (cache) {
+    NS_IF_RELEASE(cache->mAtoms[cacheIndex]);
+    NS_ADDREF(result);
+    cache->mAtoms[cacheIndex] = result;
+  }
 
-  return atom.forget();
+  return retVal.forget();
 }
 
 already_AddRefed<nsIAtom>
@@ -790,8 +888,9 @@ nsAtomFriend::AtomizeMainThread(const nsAString& aUTF16String)
     }
   }
 
-  MutexAutoLock lock(*gAtomTableLock);
-  AtomTableEntry* he = static_cast<AtomTableEntry*>(gAtomTable->Add(&key));
+  nsAtomSubTable& table = SelectAtomTable(hash);
+  MutexAutoLock lock(table.mLock);
+  AtomTableEntry* he = AddAtomEntryLocked(table, lock, key);
 
   if (he->mAtom) {
     retVal = he->mAtom;
@@ -816,8 +915,13 @@ nsrefcnt
 NS_GetNumberOfAtoms(void)
 {
   GCAtomTable(); // Trigger a GC so we return a deterministic result.
-  MutexAutoLock lock(*gAtomTableLock);
-  return gAtomTable->EntryCount();
+  nsrefcnt count = 0;
+  for (uint32_t i = 0; i < ATOM_TABLE_NUM_SHARDS; ++i) {
+    nsAtomSubTable& table = gAtomTables[i];
+    MutexAutoLock lock(table.mLock);
+    count += table.mTable.EntryCount();
+  }
+  return count;
 }
 
 int32_t
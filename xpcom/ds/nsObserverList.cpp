@@ -22,6 +22,7 @@ nsObserverList::AddObserver(nsIObserver* anObserver, bool ownsWeak)
       return NS_ERROR_OUT_OF_MEMORY;
     }
 
+    mSnapshot = nullptr;
     return NS_OK;
   }
 
@@ -35,6 +36,7 @@ nsObserverList::AddObserver(nsIObserver* anObserver, bool ownsWeak)
     return NS_ERROR_OUT_OF_MEMORY;
   }
 
+  mSnapshot = nullptr;
   return NS_OK;
 }
 
@@ -44,6 +46,7 @@ nsObserverList::RemoveObserver(nsIObserver* anObserver)
   NS_ASSERTION(anObserver, "Null input");
 
   if (mObservers.RemoveElement(static_cast<nsISupports*>(anObserver))) {
+    mSnapshot = nullptr;
     return NS_OK;
   }
 
@@ -56,6 +59,7 @@ nsObserverList::RemoveObserver(nsIObserver* anObserver)
     return NS_ERROR_FAILURE;
   }
 
+  mSnapshot = nullptr;
   return NS_OK;
 }
 
@@ -100,16 +104,55 @@ nsObserverList::AppendStrongObservers(nsCOMArray<nsIObserver>& aArray)
   }
 }
 
+already_AddRefed<ObserverListSnapshot>
+nsObserverList::GetOrCreateSnapshot()
+{
+  if (!mSnapshot) {
+    RefPtr<ObserverListSnapshot> snapshot = new ObserverListSnapshot();
+    snapshot->mRefs.SetCapacity(mObservers.Length());
+    // Last-added-first, matching FillObserverArray.
+    for (int32_t i = mObservers.Length() - 1; i >= 0; --i) {
+      snapshot->mRefs.AppendElement(mObservers[i]);
+    }
+    mSnapshot = snapshot.forget();
+  }
+  return do_AddRef(mSnapshot);
+}
+
 void
 nsObserverList::NotifyObservers(nsISupports* aSubject,
                                 const char* aTopic,
                                 const char16_t* someData)
 {
-  nsCOMArray<nsIObserver> observers;
-  FillObserverArray(observers);
+  // Iterate an immutable snapshot: reentrant add/remove during dispatch
+  // replaces the cached snapshot but cannot affect this iteration, which
+  // matches the semantics of the per-dispatch array copy this replaces.
+  RefPtr<ObserverListSnapshot> snapshot = GetOrCreateSnapshot();
+  mNotifyCount++;
+
+  bool sawDeadWeakRef = false;
+  for (ObserverRef& observer : snapshot->mRefs) {
+    if (observer.isWeakRef) {
+      nsCOMPtr<nsIObserver> strong(do_QueryReferent(observer.asWeak()));
+      if (strong) {
+        strong->Observe(aSubject, aTopic, someData);
+      } else {
+        sawDeadWeakRef = true;
+      }
+    } else {
+      observer.asObserver()->Observe(aSubject, aTopic, someData);
+    }
+  }
 
-  for (int32_t i = 0; i < observers.Count(); ++i) {
-    observers[i]->Observe(aSubject, aTopic, someData);
+  if (sawDeadWeakRef) {
+    // Drop entries whose referents have gone away, as FillObserverArray did.
+    for (int32_t i = mObservers.Length() - 1; i >= 0; --i) {
+      if (mObservers[i].isWeakRef &&
+          !nsCOMPtr<nsIObserver>(do_QueryReferent(mObservers[i].asWeak()))) {
+        mObservers.RemoveElementAt(i);
+        mSnapshot = nullptr;
+      }
+    }
   }
 }
 
@@ -41,12 +41,31 @@ struct ObserverRef
   bool operator==(nsISupports* aRhs) const { return ref == aRhs; }
 };
 
+/**
+ * An immutable, refcounted snapshot of an observer list. NotifyObservers
+ * iterates one of these without copying anything: mutations invalidate the
+ * list's cached snapshot instead of the notification path copying the
+ * observer array on every dispatch.
+ */
+class ObserverListSnapshot
+{
+public:
+  NS_INLINE_DECL_REFCOUNTING(ObserverListSnapshot)
+
+  nsTArray<ObserverRef> mRefs;
+
+private:
+  ~ObserverListSnapshot() {}
+};
+
 class nsObserverList : public nsCharPtrHashKey
 {
   friend class nsObserverService;
 
 public:
-  explicit nsObserverList(const char* aKey) : nsCharPtrHashKey(aKey)
+  explicit nsObserverList(const char* aKey)
+    : nsCharPtrHashKey(aKey)
+    , mNotifyCount(0)
   {
     MOZ_COUNT_CTOR(nsObserverList);
   }
@@ -71,8 +90,17 @@ public:
   // Like FillObserverArray(), but only for strongly held observers.
   void AppendStrongObservers(nsCOMArray<nsIObserver>& aArray);
 
+  // Number of times this topic has been dispatched, for finding pathological
+  // observer fan-out in the field; reported alongside the referent counts in
+  // nsObserverService::CollectReports.
+  uint64_t NotifyCount() const { return mNotifyCount; }
+
 private:
+  already_AddRefed<ObserverListSnapshot> GetOrCreateSnapshot();
+
   nsTArray<ObserverRef> mObservers;
+  RefPtr<ObserverListSnapshot> mSnapshot;
+  uint64_t mNotifyCount;
 };
 
 class nsObserverEnumerator final : public nsISimpleEnumerator
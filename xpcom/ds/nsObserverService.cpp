@@ -27,6 +27,9 @@
 
 static const uint32_t kMinTelemetryNotifyObserversLatencyMs = 1;
 
+// Report topics dispatched more often than this in about:memory.
+static const uint64_t kSuspectNotifyCount = 100000;
+
 // Log module for nsObserverService logging...
 //
 // To enable logging (see prlog.h for full details):
@@ -55,10 +58,22 @@ nsObserverService::CollectReports(nsIHandleReportCallback* aHandleReport,
     size_t mReferentCount;
   };
 
+  struct BusyObserver
+  {
+    BusyObserver(const char* aTopic, uint64_t aNotifyCount)
+      : mTopic(aTopic)
+      , mNotifyCount(aNotifyCount)
+    {
+    }
+    const char* mTopic;
+    uint64_t mNotifyCount;
+  };
+
   size_t totalNumStrong = 0;
   size_t totalNumWeakAlive = 0;
   size_t totalNumWeakDead = 0;
   nsTArray<SuspectObserver> suspectObservers;
+  nsTArray<BusyObserver> busyObservers;
 
   for (auto iter = mObserverTopicTable.Iter(); !iter.Done(); iter.Next()) {
     nsObserverList* observerList = iter.Get();
@@ -96,6 +111,13 @@ nsObserverService::CollectReports(nsIHandleReportCallback* aHandleReport,
       SuspectObserver suspect(observerList->GetKey(), topicTotal);
       suspectObservers.AppendElement(suspect);
     }
+
+    // Keep track of topics with pathological dispatch counts too; fan-out
+    // cost is notifications times referents.
+    if (observerList->NotifyCount() > kSuspectNotifyCount) {
+      busyObservers.AppendElement(
+        BusyObserver(observerList->GetKey(), observerList->NotifyCount()));
+    }
   }
 
   // These aren't privacy-sensitive and so don't need anonymizing.
@@ -113,6 +135,19 @@ nsObserverService::CollectReports(nsIHandleReportCallback* aHandleReport,
       aData);
   }
 
+  for (uint32_t i = 0; i < busyObservers.Length(); i++) {
+    BusyObserver& busy = busyObservers[i];
+    nsPrintfCString busyPath("observer-service-suspect/notifications(topic=%s)",
+                             busy.mTopic);
+    aHandleReport->Callback(
+      /* process */ EmptyCString(),
+      busyPath, KIND_OTHER, UNITS_COUNT, busy.mNotifyCount,
+      NS_LITERAL_CSTRING("A topic which has been dispatched a suspiciously "
+                         "large number of times; notification fan-out cost "
+                         "scales with this times the referent count."),
+      aData);
+  }
+
   MOZ_COLLECT_REPORT(
     "observer-service/referent/strong", KIND_OTHER, UNITS_COUNT,
     totalNumStrong,
@@ -167,16 +167,27 @@ nsTArray_base<Alloc, Copy>::EnsureCapacity(size_type aCapacity,
 
   Header* header;
   if (UsesAutoArrayBuffer() || !Copy::allowRealloc) {
-    // Malloc() and copy
-    header = static_cast<Header*>(ActualAlloc::Malloc(bytesToAlloc));
-    if (!header) {
-      return ActualAlloc::FailureResult();
-    }
-
-    Copy::MoveNonOverlappingRegionWithHeader(header, mHdr, Length(), aElemSize);
-
-    if (!UsesAutoArrayBuffer()) {
-      ActualAlloc::Free(mHdr);
+#ifdef MOZ_MEMORY
+    // Growing the existing allocation in place moves no elements, so it is
+    // safe even for element types which realloc must not move, and it avoids
+    // doubling peak memory on multi-megabyte arrays.
+    if (!UsesAutoArrayBuffer() &&
+        jemalloc_try_grow_in_place(mHdr, bytesToAlloc)) {
+      header = mHdr;
+    } else
+#endif
+    {
+      // Malloc() and copy
+      header = static_cast<Header*>(ActualAlloc::Malloc(bytesToAlloc));
+      if (!header) {
+        return ActualAlloc::FailureResult();
+      }
+
+      Copy::MoveNonOverlappingRegionWithHeader(header, mHdr, Length(), aElemSize);
+
+      if (!UsesAutoArrayBuffer()) {
+        ActualAlloc::Free(mHdr);
+      }
     }
   } else {
     // Realloc() existing data
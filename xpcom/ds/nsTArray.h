@@ -7,6 +7,7 @@
 #ifndef nsTArray_h__
 #define nsTArray_h__
 
+#include "mozmemory.h"
 #include "nsTArrayForwardDeclare.h"
 #include "mozilla/Alignment.h"
 #include "mozilla/ArrayIterator.h"
@@ -629,6 +629,12 @@ public:
   write(const char* aSource, uint32_t aSourceLength)
   {
     char* cp = const_cast<char*>(aSource);
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+    if (mozilla::supports_sse2()) {
+      mozilla::SSE2::ToUpperCaseASCII(cp, cp, aSourceLength);
+      return aSourceLength;
+    }
+#endif
     const char* end = aSource + aSourceLength;
     while (cp != end) {
       char ch = *cp;
@@ -669,6 +675,13 @@ public:
   {
     uint32_t len = XPCOM_MIN(uint32_t(mEnd - mIter), aSourceLength);
     char* cp = mIter.get();
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+    if (mozilla::supports_sse2()) {
+      mozilla::SSE2::ToUpperCaseASCII(cp, aSource, len);
+      mIter.advance(len);
+      return len;
+    }
+#endif
     const char* end = aSource + len;
     while (aSource != end) {
       char ch = *aSource;
@@ -713,6 +726,12 @@ public:
   write(const char* aSource, uint32_t aSourceLength)
   {
     char* cp = const_cast<char*>(aSource);
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+    if (mozilla::supports_sse2()) {
+      mozilla::SSE2::ToLowerCaseASCII(cp, cp, aSourceLength);
+      return aSourceLength;
+    }
+#endif
     const char* end = aSource + aSourceLength;
     while (cp != end) {
       char ch = *cp;
@@ -753,6 +772,13 @@ public:
   {
     uint32_t len = XPCOM_MIN(uint32_t(mEnd - mIter), aSourceLength);
     char* cp = mIter.get();
+#ifdef MOZILLA_MAY_SUPPORT_SSE2
+    if (mozilla::supports_sse2()) {
+      mozilla::SSE2::ToLowerCaseASCII(cp, aSource, len);
+      mIter.advance(len);
+      return len;
+    }
+#endif
     const char* end = aSource + len;
     while (aSource != end) {
       char ch = *aSource;
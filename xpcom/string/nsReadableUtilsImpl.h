@@ -50,5 +50,9 @@ namespace SSE2 {
 
 int32_t FirstNonASCII(const char16_t* aBegin, const char16_t* aEnd);
 
+// In-place (aDest may equal aSource) bulk ASCII case conversion.
+void ToLowerCaseASCII(char* aDest, const char* aSource, size_t aLength);
+void ToUpperCaseASCII(char* aDest, const char* aSource, size_t aLength);
+
 } // namespace SSE2
 } // namespace mozilla
@@ -66,5 +66,50 @@ FirstNonASCII(const char16_t* aBegin, const char16_t* aEnd)
   return -1;
 }
 
+// Convert the 26 ASCII letters of one case to the other by adding or
+// subtracting 0x20 wherever a byte lies in the letter range. The signed
+// compares are safe: the letter ranges are entirely below 0x80, and bytes at
+// or above 0x80 read as negative and fail the lower-bound compare.
+
+static inline void
+ConvertCaseVectorized(char* aDest, const char* aSource, size_t aLength,
+                      char aRangeBegin, char aRangeEnd, char aDelta)
+{
+  const size_t kBytesPerVector = sizeof(__m128i);
+  const __m128i lowerBound = _mm_set1_epi8(aRangeBegin - 1);
+  const __m128i upperBound = _mm_set1_epi8(aRangeEnd + 1);
+  const __m128i delta = _mm_set1_epi8(aDelta);
+
+  size_t i = 0;
+  for (; aLength - i >= kBytesPerVector; i += kBytesPerVector) {
+    __m128i vect =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(aSource + i));
+    __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(vect, lowerBound),
+                                     _mm_cmplt_epi8(vect, upperBound));
+    vect = _mm_add_epi8(vect, _mm_and_si128(isLetter, delta));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(aDest + i), vect);
+  }
+
+  for (; i < aLength; i++) {
+    char ch = aSource[i];
+    if (ch >= aRangeBegin && ch <= aRangeEnd) {
+      ch += aDelta;
+    }
+    aDest[i] = ch;
+  }
+}
+
+void
+ToLowerCaseASCII(char* aDest, const char* aSource, size_t aLength)
+{
+  ConvertCaseVectorized(aDest, aSource, aLength, 'A', 'Z', 'a' - 'A');
+}
+
+void
+ToUpperCaseASCII(char* aDest, const char* aSource, size_t aLength)
+{
+  ConvertCaseVectorized(aDest, aSource, aLength, 'a', 'z', 'A' - 'a');
+}
+
 } // namespace SSE2
 } // namespace mozilla
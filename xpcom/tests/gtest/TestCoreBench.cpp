@@ -0,0 +1,154 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Microbenchmarks for the core data structures (PLDHashTable, nsTArray,
+// mozilla::Vector, nsTSubstring) so regressions show up before shipping.
+// Run them all with: mach gtest "CoreBench.*"
+// Timings are reported through the MozGTestBench perf machinery.
+
+#include "PLDHashTable.h"
+#include "mozilla/HashFunctions.h"
+#include "mozilla/Vector.h"
+#include "nsString.h"
+#include "nsTArray.h"
+#include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h" // For MOZ_GTEST_BENCH
+
+using namespace mozilla;
+
+namespace {
+
+struct BenchEntry : public PLDHashEntryHdr
+{
+  uintptr_t mKey;
+};
+
+static PLDHashNumber
+BenchHash(const void* aKey)
+{
+  return HashGeneric(uintptr_t(aKey));
+}
+
+static bool
+BenchMatch(const PLDHashEntryHdr* aEntry, const void* aKey)
+{
+  return static_cast<const BenchEntry*>(aEntry)->mKey == uintptr_t(aKey);
+}
+
+static const PLDHashTableOps kBenchOps = {
+  BenchHash,
+  BenchMatch,
+  PLDHashTable::MoveEntryStub,
+  PLDHashTable::ClearEntryStub,
+  nullptr
+};
+
+// Sizes chosen to roughly match observed consumers: mid-size tables
+// (nsTHashtable users), parser-style string accumulation, and display-item
+// sized array growth.
+static const uint32_t kHashEntries = 65536;
+static const uint32_t kHashLookups = 1 << 20;
+static const uint32_t kArrayElements = 1 << 20;
+static const uint32_t kStringAppends = 1 << 16;
+
+} // namespace
+
+MOZ_GTEST_BENCH(CoreBench, PLDHashInsertRemoveMix, [] {
+  PLDHashTable table(&kBenchOps, sizeof(BenchEntry));
+  for (uint32_t round = 0; round < 8; round++) {
+    for (uint32_t i = 0; i < kHashEntries; i++) {
+      auto entry = static_cast<BenchEntry*>(
+        table.Add(reinterpret_cast<void*>(uintptr_t(i * 2654435761u))));
+      entry->mKey = uintptr_t(i * 2654435761u);
+    }
+    for (uint32_t i = 0; i < kHashEntries; i += 2) {
+      table.Remove(reinterpret_cast<void*>(uintptr_t(i * 2654435761u)));
+    }
+  }
+});
+
+MOZ_GTEST_BENCH(CoreBench, PLDHashLookupHitMiss, [] {
+  PLDHashTable table(&kBenchOps, sizeof(BenchEntry));
+  for (uint32_t i = 0; i < kHashEntries; i++) {
+    auto entry = static_cast<BenchEntry*>(
+      table.Add(reinterpret_cast<void*>(uintptr_t(i * 2654435761u))));
+    entry->mKey = uintptr_t(i * 2654435761u);
+  }
+  uint32_t hits = 0;
+  for (uint32_t i = 0; i < kHashLookups; i++) {
+    // Every other probe misses, matching the mixed pattern most consumers
+    // show in profiles.
+    uintptr_t key = uintptr_t((i % (kHashEntries * 2)) * 2654435761u);
+    if (table.Search(reinterpret_cast<void*>(key))) {
+      hits++;
+    }
+  }
+  ASSERT_GT(hits, 0u);
+});
+
+MOZ_GTEST_BENCH(CoreBench, TArrayAppendGrowth, [] {
+  nsTArray<uint64_t> array;
+  for (uint32_t i = 0; i < kArrayElements; i++) {
+    array.AppendElement(uint64_t(i));
+  }
+  ASSERT_EQ(array.Length(), kArrayElements);
+});
+
+MOZ_GTEST_BENCH(CoreBench, TArrayPresizedFill, [] {
+  nsTArray<uint64_t> array;
+  array.SetCapacity(kArrayElements);
+  for (uint32_t i = 0; i < kArrayElements; i++) {
+    array.AppendElement(uint64_t(i));
+  }
+  ASSERT_EQ(array.Length(), kArrayElements);
+});
+
+MOZ_GTEST_BENCH(CoreBench, VectorAppendGrowth, [] {
+  Vector<uint64_t> vector;
+  for (uint32_t i = 0; i < kArrayElements; i++) {
+    MOZ_RELEASE_ASSERT(vector.append(uint64_t(i)));
+  }
+  ASSERT_EQ(vector.length(), size_t(kArrayElements));
+});
+
+MOZ_GTEST_BENCH(CoreBench, StringAppend, [] {
+  nsAutoCString str;
+  for (uint32_t i = 0; i < kStringAppends; i++) {
+    str.AppendLiteral("0123456789abcdef");
+  }
+  ASSERT_EQ(str.Length(), kStringAppends * 16);
+});
+
+MOZ_GTEST_BENCH(CoreBench, StringFind, [] {
+  nsCString haystack;
+  for (uint32_t i = 0; i < kStringAppends; i++) {
+    haystack.AppendLiteral("0123456789abcdef");
+  }
+  haystack.AppendLiteral("needle");
+
+  uint32_t found = 0;
+  for (uint32_t i = 0; i < 64; i++) {
+    if (haystack.Find("needle") != kNotFound) {
+      found++;
+    }
+  }
+  ASSERT_EQ(found, 64u);
+});
+
+MOZ_GTEST_BENCH(CoreBench, StringEqualsIgnoreCase, [] {
+  nsCString a, b;
+  for (uint32_t i = 0; i < 4096; i++) {
+    a.AppendLiteral("CONTENT-type");
+    b.AppendLiteral("content-TYPE");
+  }
+  uint32_t equal = 0;
+  for (uint32_t i = 0; i < 256; i++) {
+    if (a.Equals(b, nsCaseInsensitiveCStringComparator())) {
+      equal++;
+    }
+  }
+  ASSERT_EQ(equal, 256u);
+});
@@ -0,0 +1,166 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "mozilla/FlatHashTable.h"
+#include "mozilla/HashFunctions.h"
+#include "PLDHashTable.h"
+#include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h" // For MOZ_GTEST_BENCH
+
+using namespace mozilla;
+
+namespace {
+
+struct IntEntry
+{
+  typedef uint32_t KeyType;
+
+  explicit IntEntry(uint32_t aKey)
+    : mKey(aKey)
+    , mValue(0)
+  {
+  }
+
+  static uint32_t HashKey(uint32_t aKey) { return HashGeneric(aKey); }
+  bool KeyEquals(uint32_t aKey) const { return mKey == aKey; }
+  uint32_t GetKey() const { return mKey; }
+
+  uint32_t mKey;
+  uint32_t mValue;
+};
+
+} // namespace
+
+TEST(FlatHashTable, AddSearchRemove)
+{
+  FlatHashTable<IntEntry> table;
+  EXPECT_EQ(table.Count(), 0u);
+
+  static const uint32_t N = 10000;
+  for (uint32_t i = 0; i < N; i++) {
+    IntEntry* entry = table.Add(i);
+    ASSERT_TRUE(entry);
+    entry->mValue = i * 2;
+  }
+  EXPECT_EQ(table.Count(), N);
+
+  // Adding an existing key returns the existing entry.
+  IntEntry* existing = table.Add(42);
+  ASSERT_TRUE(existing);
+  EXPECT_EQ(existing->mValue, 84u);
+  EXPECT_EQ(table.Count(), N);
+
+  for (uint32_t i = 0; i < N; i++) {
+    IntEntry* entry = table.Search(i);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(entry->mValue, i * 2);
+  }
+  EXPECT_FALSE(table.Search(N + 1));
+
+  // Remove the odd keys and recheck.
+  for (uint32_t i = 1; i < N; i += 2) {
+    table.Remove(i);
+  }
+  EXPECT_EQ(table.Count(), N / 2);
+  for (uint32_t i = 0; i < N; i++) {
+    IntEntry* entry = table.Search(i);
+    if (i % 2 == 0) {
+      ASSERT_TRUE(entry);
+      EXPECT_EQ(entry->mValue, i * 2);
+    } else {
+      EXPECT_FALSE(entry);
+    }
+  }
+
+  // Probe chains must survive heavy add/remove churn through tombstones.
+  for (uint32_t round = 0; round < 4; round++) {
+    for (uint32_t i = 1; i < N; i += 2) {
+      ASSERT_TRUE(table.Add(i));
+    }
+    for (uint32_t i = 1; i < N; i += 2) {
+      table.Remove(i);
+    }
+  }
+  EXPECT_EQ(table.Count(), N / 2);
+
+  uint32_t iterated = 0;
+  for (auto iter = table.Iter(); !iter.Done(); iter.Next()) {
+    EXPECT_EQ(iter.Get()->mKey % 2, 0u);
+    iterated++;
+  }
+  EXPECT_EQ(iterated, N / 2);
+
+  table.Clear();
+  EXPECT_EQ(table.Count(), 0u);
+  EXPECT_FALSE(table.Search(0));
+}
+
+// Benchmark against PLDHashTable on a pointer-like integer key distribution
+// (the dominant nsTHashtable pattern).
+
+namespace {
+
+struct BenchPLDEntry : public PLDHashEntryHdr
+{
+  uint32_t mKey;
+};
+
+static PLDHashNumber
+BenchHashKey(const void* aKey)
+{
+  return HashGeneric(uint32_t(uintptr_t(aKey)));
+}
+
+static bool
+BenchMatchEntry(const PLDHashEntryHdr* aEntry, const void* aKey)
+{
+  return static_cast<const BenchPLDEntry*>(aEntry)->mKey ==
+         uint32_t(uintptr_t(aKey));
+}
+
+static const PLDHashTableOps kBenchOps = {
+  BenchHashKey,
+  BenchMatchEntry,
+  PLDHashTable::MoveEntryStub,
+  PLDHashTable::ClearEntryStub,
+  nullptr
+};
+
+static const uint32_t kBenchSize = 100000;
+static const uint32_t kBenchLookups = 1000000;
+
+} // namespace
+
+MOZ_GTEST_BENCH(FlatHashTable, PerfFlatSearch, [] {
+  FlatHashTable<IntEntry> table;
+  for (uint32_t i = 0; i < kBenchSize; i++) {
+    table.Add(i * 2654435761u);
+  }
+  uint32_t found = 0;
+  for (uint32_t i = 0; i < kBenchLookups; i++) {
+    if (table.Search((i % kBenchSize) * 2654435761u)) {
+      found++;
+    }
+  }
+  ASSERT_EQ(found, kBenchLookups);
+});
+
+MOZ_GTEST_BENCH(FlatHashTable, PerfPLDHashSearch, [] {
+  PLDHashTable table(&kBenchOps, sizeof(BenchPLDEntry));
+  for (uint32_t i = 0; i < kBenchSize; i++) {
+    auto entry = static_cast<BenchPLDEntry*>(
+      table.Add(reinterpret_cast<void*>(uintptr_t(i * 2654435761u))));
+    entry->mKey = i * 2654435761u;
+  }
+  uint32_t found = 0;
+  for (uint32_t i = 0; i < kBenchLookups; i++) {
+    if (table.Search(
+          reinterpret_cast<void*>(uintptr_t((i % kBenchSize) * 2654435761u)))) {
+      found++;
+    }
+  }
+  ASSERT_EQ(found, kBenchLookups);
+});
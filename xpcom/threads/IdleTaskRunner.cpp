@@ -11,6 +11,8 @@
 
 namespace mozilla {
 
+static LinkedList<IdleTaskRunner>* IdleRunnerRegistry();
+
 already_AddRefed<IdleTaskRunner>
 IdleTaskRunner::Create(const CallbackType& aCallback,
                        const char* aRunnableName, uint32_t aDelay,
@@ -43,8 +45,22 @@ IdleTaskRunner::IdleTaskRunner(const CallbackType& aCallback,
   , mMayStopProcessing(aMayStopProcessing)
   , mTaskCategory(aTaskCategory)
 {
+  MOZ_ASSERT(NS_IsMainThread());
+  IdleRunnerRegistry()->insertBack(this);
+}
+
+// The registry of live runners; see the class comment. Main thread only.
+static LinkedList<IdleTaskRunner>*
+IdleRunnerRegistry()
+{
+  static LinkedList<IdleTaskRunner>* sRegistry = new LinkedList<IdleTaskRunner>();
+  return sRegistry;
 }
 
+// True while a runner is handing out its leftover idle budget, to stop
+// nested coalescing.
+static bool sCoalescingIdleBudget = false;
+
 NS_IMETHODIMP
 IdleTaskRunner::Run()
 {
@@ -74,6 +90,33 @@ IdleTaskRunner::Run()
     mCallback = nullptr;
   }
 
+  // Offer the rest of this idle period to the other registered runners so
+  // they do not each wake the thread separately. Collect them first: a
+  // callback may cancel or destroy other runners while running.
+  if (didRun && !deadLineWasNull && !sCoalescingIdleBudget) {
+    AutoTArray<RefPtr<IdleTaskRunner>, 8> others;
+    for (IdleTaskRunner* runner : *IdleRunnerRegistry()) {
+      if (runner != this && runner->mCallback) {
+        others.AppendElement(runner);
+      }
+    }
+
+    sCoalescingIdleBudget = true;
+    for (RefPtr<IdleTaskRunner>& runner : others) {
+      TimeStamp now = TimeStamp::Now();
+      if (!runner->mCallback || now + runner->mBudget >= mDeadline) {
+        continue;
+      }
+      if (runner->mMayStopProcessing && runner->mMayStopProcessing()) {
+        runner->mCallback = nullptr;
+        continue;
+      }
+      runner->SetDeadline(mDeadline);
+      runner->Run();
+    }
+    sCoalescingIdleBudget = false;
+  }
+
   return NS_OK;
 }
 
@@ -167,6 +210,9 @@ IdleTaskRunner::Schedule(bool aAllowIdleDispatch)
 IdleTaskRunner::~IdleTaskRunner()
 {
   CancelTimer();
+  if (isInList()) {
+    removeFrom(*IdleRunnerRegistry());
+  }
 }
 
 void
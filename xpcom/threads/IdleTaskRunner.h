@@ -7,6 +7,7 @@
 #ifndef IdleTaskRunner_h
 #define IdleTaskRunner_h
 
+#include "mozilla/LinkedList.h"
 #include "mozilla/TimeStamp.h"
 #include "mozilla/TaskCategory.h"
 #include "nsThreadUtils.h"
@@ -19,7 +20,14 @@ namespace mozilla {
 // one has to either explicitly Cancel() the runner or have
 // MayContinueProcessing() callback return false to completely remove
 // the runner.
+// All live runners are kept on a main-thread registry so that one idle
+// wakeup can be shared: when a runner finishes its callback with idle budget
+// to spare, the remainder is offered to the other registered runners instead
+// of each of them arming its own timer. This coalesces the wakeups of the
+// idle-time consumers (GC and CC slices, cache expiration, startup cache
+// writes) that otherwise collide.
 class IdleTaskRunner final : public IdleRunnable
+                           , public LinkedListElement<IdleTaskRunner>
 {
 public:
   // Return true if some meaningful work was done.
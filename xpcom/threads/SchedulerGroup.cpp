@@ -389,12 +389,14 @@ SchedulerGroup::Runnable::Run()
 
   nsresult result;
 
+  TimeStamp start = TimeStamp::Now();
   {
 #ifdef EARLY_BETA_OR_EARLIER
     AutoCollectVsyncTelemetry telemetry(this);
 #endif
     result = mRunnable->Run();
   }
+  mGroup->NoteRunnableExecuted(TimeStamp::Now() - start);
 
   // The runnable's destructor can have side effects, so try to execute it in
   // the scope of the TabGroup.
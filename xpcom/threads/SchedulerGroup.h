@@ -105,6 +105,20 @@ public:
     return mEventCount == 0 ? NoLongerQueued : StillQueued;
   }
 
+  // Cumulative main-thread wall time spent running this group's labeled
+  // runnables, and how many have run. Only main-thread accessed (runnables
+  // for a group all execute there), so no synchronization is needed. Used to
+  // attribute jank to a tab.
+  mozilla::TimeDuration TotalExecutionTime() const { return mTotalExecutionTime; }
+  uint64_t ExecutedRunnableCount() const { return mExecutedRunnableCount; }
+
+  void NoteRunnableExecuted(mozilla::TimeDuration aDuration)
+  {
+    MOZ_ASSERT(NS_IsMainThread());
+    mTotalExecutionTime += aDuration;
+    mExecutedRunnableCount++;
+  }
+
   class Runnable final : public mozilla::Runnable
                        , public nsIRunnablePriority
                        , public nsILabelableRunnable
@@ -201,6 +215,10 @@ protected:
   // (across all queues).
   size_t mEventCount = 0;
 
+  // See TotalExecutionTime() / ExecutedRunnableCount().
+  mozilla::TimeDuration mTotalExecutionTime;
+  uint64_t mExecutedRunnableCount = 0;
+
   nsCOMPtr<nsISerialEventTarget> mEventTargets[size_t(TaskCategory::Count)];
   RefPtr<AbstractThread> mAbstractThreads[size_t(TaskCategory::Count)];
 };
@@ -694,6 +694,28 @@ TimerThread::AddTimerInternal(nsTimerImpl* aTimer)
   return true;
 }
 
+void
+TimerThread::CancelTimersForTarget(nsIEventTarget* aTarget)
+{
+  // Collect the matching timers under the lock, but run their Cancel()
+  // outside it: Cancel() re-enters RemoveTimer (harmlessly, since the holder
+  // has been dropped by Take()) and releases arbitrary callback closures.
+  nsTArray<RefPtr<nsTimerImpl>> cancelled;
+  {
+    MonitorAutoLock lock(mMonitor);
+    for (UniquePtr<Entry>& entry : mTimers) {
+      nsTimerImpl* timer = entry->Value();
+      if (timer && timer->mEventTarget == aTarget) {
+        cancelled.AppendElement(entry->Take());
+      }
+    }
+  }
+
+  for (RefPtr<nsTimerImpl>& timer : cancelled) {
+    timer->Cancel();
+  }
+}
+
 bool
 TimerThread::RemoveTimerInternal(nsTimerImpl* aTimer)
 {
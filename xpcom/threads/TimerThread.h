@@ -47,6 +47,12 @@ public:
 
   nsresult AddTimer(nsTimerImpl* aTimer);
   nsresult RemoveTimer(nsTimerImpl* aTimer);
+
+  // Cancel every pending timer whose event target is aTarget with a single
+  // lock acquisition. Used for bulk teardown (e.g. a window going away),
+  // where cancelling a large timer population one call at a time is
+  // quadratic in practice.
+  void CancelTimersForTarget(nsIEventTarget* aTarget);
   TimeStamp FindNextFireTimeForCurrentThread(TimeStamp aDefault, uint32_t aSearchBound);
 
   void DoBeforeSleep();
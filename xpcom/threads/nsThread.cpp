@@ -19,6 +19,7 @@
 #include "nsIClassInfoImpl.h"
 #include "nsAutoPtr.h"
 #include "nsCOMPtr.h"
+#include "nsClassHashtable.h"
 #include "nsQueryObject.h"
 #include "pratom.h"
 #include "mozilla/CycleCollectedJSContext.h"
@@ -35,6 +36,7 @@
 #include "nsXPCOMPrivate.h"
 #include "mozilla/ChaosMode.h"
 #include "mozilla/Telemetry.h"
+#include "mozilla/StaticMutex.h"
 #include "mozilla/TimeStamp.h"
 #include "mozilla/Unused.h"
 #include "mozilla/dom/ScriptSettings.h"
@@ -909,6 +911,75 @@ GetLabeledRunnableName(nsIRunnable* aEvent, nsACString& aName)
 }
 #endif
 
+// Long-task watchdog. Main-thread runnables that run longer than the
+// threshold are accumulated in a process-wide offender table keyed by the
+// runnable name and emit a profiler marker. The fast path costs two
+// TimeStamp reads; names are only queried once a runnable has already proven
+// slow.
+struct LongTaskEntry
+{
+  uint64_t mCount = 0;
+  double mTotalMs = 0;
+  double mMaxMs = 0;
+};
+
+static StaticMutex sLongTaskStatsLock;
+static nsClassHashtable<nsCStringHashKey, LongTaskEntry>* sLongTaskStats;
+
+static uint32_t
+LongTaskThresholdMs()
+{
+  static uint32_t sThreshold = [] {
+    if (const char* env = PR_GetEnv("MOZ_LONG_TASK_THRESHOLD_MS")) {
+      if (uint32_t value = atoi(env)) {
+        return value;
+      }
+    }
+    return 100u;
+  }();
+  return sThreshold;
+}
+
+static void
+NoteLongTask(nsIRunnable* aEvent, double aDurationMs)
+{
+  nsAutoCString name;
+  if (nsCOMPtr<nsINamed> named = do_QueryInterface(aEvent)) {
+    named->GetName(name);
+  }
+  if (name.IsEmpty()) {
+    name.AssignLiteral("anonymous runnable");
+  }
+
+  profiler_add_marker(name.get());
+
+  StaticMutexAutoLock lock(sLongTaskStatsLock);
+  if (!sLongTaskStats) {
+    sLongTaskStats = new nsClassHashtable<nsCStringHashKey, LongTaskEntry>();
+  }
+  LongTaskEntry* entry = sLongTaskStats->LookupOrAdd(name);
+  entry->mCount++;
+  entry->mTotalMs += aDurationMs;
+  entry->mMaxMs = std::max(entry->mMaxMs, aDurationMs);
+}
+
+void
+mozilla::CollectLongTaskStats(nsTArray<mozilla::LongTaskStat>& aStats)
+{
+  StaticMutexAutoLock lock(sLongTaskStatsLock);
+  if (!sLongTaskStats) {
+    return;
+  }
+  for (auto iter = sLongTaskStats->Iter(); !iter.Done(); iter.Next()) {
+    LongTaskStat* stat = aStats.AppendElement();
+    stat->mName = iter.Key();
+    stat->mCount = iter.Data()->mCount;
+    stat->mTotalMs = iter.Data()->mTotalMs;
+    stat->mMaxMs = iter.Data()->mMaxMs;
+  }
+  aStats.Sort(LongTaskStatComparator());
+}
+
 NS_IMETHODIMP
 nsThread::ProcessNextEvent(bool aMayWait, bool* aResult)
 {
@@ -1036,7 +1107,16 @@ nsThread::ProcessNextEvent(bool aMayWait, bool* aResult)
       if (priority == EventPriority::Input) {
         timeDurationHelper.emplace();
       }
-      event->Run();
+      if (MAIN_THREAD == mIsMainThread) {
+        TimeStamp runStart = TimeStamp::Now();
+        event->Run();
+        double runMs = (TimeStamp::Now() - runStart).ToMilliseconds();
+        if (MOZ_UNLIKELY(runMs >= LongTaskThresholdMs())) {
+          NoteLongTask(event, runMs);
+        }
+      } else {
+        event->Run();
+      }
     } else if (aMayWait) {
       MOZ_ASSERT(ShuttingDown(),
                  "This should only happen when shutting down");
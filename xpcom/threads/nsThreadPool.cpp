@@ -49,6 +49,11 @@ nsThreadPool::nsThreadPool()
   , mIdleCount(0)
   , mStackSize(nsIThreadManager::DEFAULT_STACK_SIZE)
   , mShutdown(false)
+  , mWorkStealing(false)
+  , mDispatchCursor(0)
+  , mNextWorkerIndex(0)
+  , mPendingEvents(0)
+  , mStealCount(0)
 {
   LOG(("THRD-P(%p) constructor!!!\n", this));
 }
@@ -85,15 +90,27 @@ nsThreadPool::PutEvent(already_AddRefed<nsIRunnable> aEvent, uint32_t aFlags)
     MOZ_ASSERT(mIdleCount <= (uint32_t)mThreads.Count(), "oops");
 
     // Make sure we have a thread to service this event.
+    uint32_t pendingCount = mWorkStealing ? uint32_t(mPendingEvents)
+                                          : mEvents.Count(lock);
     if (mThreads.Count() < (int32_t)mThreadLimit &&
         !(aFlags & NS_DISPATCH_AT_END) &&
         // Spawn a new thread if we don't have enough idle threads to serve
         // pending events immediately.
-        mEvents.Count(lock) >= mIdleCount) {
+        pendingCount >= mIdleCount) {
       spawnThread = true;
     }
 
-    mEvents.PutEvent(Move(aEvent), EventPriority::Normal, lock);
+    if (mWorkStealing) {
+      // Distribute events over the worker queues; only the wakeup
+      // notification and the bookkeeping above touch the pool mutex.
+      WorkerQueue& queue =
+        *mWorkerQueues[mDispatchCursor++ % mWorkerQueues.Length()];
+      MutexAutoLock queueLock(queue.mLock);
+      queue.mQueue.PutEvent(Move(aEvent), EventPriority::Normal, queueLock);
+      mPendingEvents++;
+    } else {
+      mEvents.PutEvent(Move(aEvent), EventPriority::Normal, lock);
+    }
     mEventsAvailable.Notify();
     stackSize = mStackSize;
   }
@@ -150,6 +167,26 @@ nsThreadPool::ShutdownThread(nsIThread* aThread)
         "nsIThread::AsyncShutdown", aThread, &nsIThread::AsyncShutdown));
 }
 
+already_AddRefed<nsIRunnable>
+nsThreadPool::StealingGetEvent(uint32_t aWorkerIndex)
+{
+  // Scan our own queue first, then the other workers' queues in order.
+  uint32_t queueCount = mWorkerQueues.Length();
+  for (uint32_t i = 0; i < queueCount; i++) {
+    WorkerQueue& queue = *mWorkerQueues[(aWorkerIndex + i) % queueCount];
+    MutexAutoLock queueLock(queue.mLock);
+    nsCOMPtr<nsIRunnable> event = queue.mQueue.GetEvent(nullptr, queueLock);
+    if (event) {
+      mPendingEvents--;
+      if (i != 0) {
+        mStealCount++;
+      }
+      return event.forget();
+    }
+  }
+  return nullptr;
+}
+
 NS_IMETHODIMP
 nsThreadPool::Run()
 {
@@ -173,12 +210,32 @@ nsThreadPool::Run()
     listener->OnThreadCreated();
   }
 
+  // In work-stealing mode each worker has a home queue. mWorkStealing can
+  // only change before any event is dispatched, so reading it unlocked here
+  // is safe.
+  uint32_t workerIndex = 0;
+  if (mWorkStealing) {
+    workerIndex = mNextWorkerIndex++ % mWorkerQueues.Length();
+  }
+
   do {
     nsCOMPtr<nsIRunnable> event;
+    if (mWorkStealing) {
+      event = StealingGetEvent(workerIndex);
+    }
     {
       MutexAutoLock lock(mMutex);
 
-      event = mEvents.GetEvent(nullptr, lock);
+      if (!event) {
+        if (mWorkStealing) {
+          // Re-scan under the pool mutex: a dispatcher pushes to a worker
+          // queue before notifying under this mutex, so a push cannot slip
+          // between this scan and the Wait() below unobserved.
+          event = StealingGetEvent(workerIndex);
+        } else {
+          event = mEvents.GetEvent(nullptr, lock);
+        }
+      }
       if (!event) {
         PRIntervalTime now     = PR_IntervalNow();
         PRIntervalTime timeout = PR_MillisecondsToInterval(mIdleThreadTimeout);
@@ -448,6 +505,43 @@ nsThreadPool::SetListener(nsIThreadPoolListener* aListener)
   return NS_OK;
 }
 
+NS_IMETHODIMP
+nsThreadPool::GetWorkStealing(bool* aWorkStealing)
+{
+  MutexAutoLock lock(mMutex);
+  *aWorkStealing = mWorkStealing;
+  return NS_OK;
+}
+
+NS_IMETHODIMP
+nsThreadPool::SetWorkStealing(bool aWorkStealing)
+{
+  MutexAutoLock lock(mMutex);
+  // The mode only switches safely while the pool is quiescent.
+  if (mThreads.Count() != 0 || mEvents.Count(lock) != 0 || mPendingEvents != 0) {
+    return NS_ERROR_NOT_AVAILABLE;
+  }
+  if (aWorkStealing == mWorkStealing) {
+    return NS_OK;
+  }
+
+  mWorkerQueues.Clear();
+  if (aWorkStealing) {
+    for (uint32_t i = 0; i < mThreadLimit; i++) {
+      mWorkerQueues.AppendElement(mozilla::MakeUnique<WorkerQueue>());
+    }
+  }
+  mWorkStealing = aWorkStealing;
+  return NS_OK;
+}
+
+NS_IMETHODIMP
+nsThreadPool::GetStealCount(uint64_t* aStealCount)
+{
+  *aStealCount = mStealCount;
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 nsThreadPool::SetName(const nsACString& aName)
 {
@@ -11,13 +11,16 @@
 #include "nsIThread.h"
 #include "nsIRunnable.h"
 #include "nsCOMArray.h"
+#include "nsTArray.h"
 #include "nsCOMPtr.h"
 #include "nsThreadUtils.h"
 #include "mozilla/Attributes.h"
 #include "mozilla/AlreadyAddRefed.h"
 #include "mozilla/EventQueue.h"
 #include "mozilla/Mutex.h"
+#include "mozilla/Atomics.h"
 #include "mozilla/Monitor.h"
+#include "mozilla/UniquePtr.h"
 
 class nsThreadPool final
   : public nsIThreadPool
@@ -38,6 +41,18 @@ private:
   nsresult PutEvent(nsIRunnable* aEvent);
   nsresult PutEvent(already_AddRefed<nsIRunnable> aEvent, uint32_t aFlags);
 
+  // In work-stealing mode each worker owns one of these; an idle worker
+  // scans the others. See nsIThreadPool::workStealing.
+  struct WorkerQueue
+  {
+    WorkerQueue() : mLock("nsThreadPool.WorkerQueue") {}
+
+    mozilla::Mutex mLock;
+    mozilla::EventQueue mQueue;
+  };
+
+  already_AddRefed<nsIRunnable> StealingGetEvent(uint32_t aWorkerIndex);
+
   nsCOMArray<nsIThread> mThreads;
   mozilla::Mutex        mMutex;
   mozilla::CondVar      mEventsAvailable;
@@ -49,6 +64,12 @@ private:
   uint32_t              mStackSize;
   nsCOMPtr<nsIThreadPoolListener> mListener;
   bool                  mShutdown;
+  bool                  mWorkStealing;
+  nsTArray<mozilla::UniquePtr<WorkerQueue>> mWorkerQueues;
+  mozilla::Atomic<uint32_t> mDispatchCursor;
+  mozilla::Atomic<uint32_t> mNextWorkerIndex;
+  mozilla::Atomic<int32_t>  mPendingEvents;
+  mozilla::Atomic<uint64_t> mStealCount;
   nsCString             mName;
   nsThreadPoolNaming    mThreadNaming;
 };
@@ -271,6 +271,39 @@ extern bool NS_ProcessNextEvent(nsIThread* aThread = nullptr,
 // into NS_ProcessNextEvent for a tiny efficiency win.
 namespace mozilla {
 
+/**
+ * A snapshot entry from the main-thread long-task offender table; see
+ * CollectLongTaskStats. Runnables whose Run() exceeds the watchdog threshold
+ * (MOZ_LONG_TASK_THRESHOLD_MS, default 100ms) are accumulated by name.
+ */
+struct LongTaskStat
+{
+  nsCString mName;
+  uint64_t mCount;
+  double mTotalMs;
+  double mMaxMs;
+};
+
+struct LongTaskStatComparator
+{
+  bool Equals(const LongTaskStat& aA, const LongTaskStat& aB) const
+  {
+    return aA.mTotalMs == aB.mTotalMs;
+  }
+  bool LessThan(const LongTaskStat& aA, const LongTaskStat& aB) const
+  {
+    return aA.mTotalMs > aB.mTotalMs;
+  }
+};
+
+// Fill aStats with the offender table, ranked by cumulative time descending.
+// Safe to call from any thread.
+void CollectLongTaskStats(nsTArray<LongTaskStat>& aStats);
+
+} // namespace mozilla
+
+namespace mozilla {
+
 // You should normally not need to deal with this template parameter.  If
 // you enjoy esoteric event loop details, read on.
 //
@@ -56,6 +56,14 @@ NS_GetTimerDeadlineHintOnCurrentThread(TimeStamp aDefault, uint32_t aSearchBound
            : TimeStamp();
 }
 
+void
+NS_CancelTimersForTarget(nsIEventTarget* aTarget)
+{
+  if (gThread) {
+    gThread->CancelTimersForTarget(aTarget);
+  }
+}
+
 // This module prints info about which timers are firing, which is useful for
 // wakeups for the purposes of power profiling. Set the following environment
 // variable before starting the browser.